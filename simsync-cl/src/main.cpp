@@ -1,13 +1,33 @@
 #include <simsync/application.hpp>
 #include <simsync/architecture.hpp>
+#include <simsync/bounds.hpp>
+#include <simsync/co_schedule.hpp>
 #include <simsync/estimate.hpp>
+#include <simsync/hot_locks.hpp>
+#include <simsync/lock_elision.hpp>
+#include <simsync/monte_carlo.hpp>
+#include <simsync/simulation.hpp>
+#include <simsync/sweep.hpp>
 #include <simsync/system.hpp>
 
+#include <simsync/parallel.hpp>
+
+#include <simsync/reports/completion_time.hpp>
+#include <simsync/reports/cpi_sensitivity.hpp>
+#include <simsync/reports/energy_use.hpp>
 #include <simsync/reports/event_trace.hpp>
+#include <simsync/reports/happens_before.hpp>
+#include <simsync/reports/migrations.hpp>
 #include <simsync/reports/scheduler_trace.hpp>
 #include <simsync/reports/criticality_stack.hpp>
 #include <simsync/reports/time_stack.hpp>
 
+#include <glob.h>
+
+#include <csignal>
+
+#include <algorithm>
+#include <fstream>
 #include <iostream>
 #include <sstream>
 
@@ -18,10 +38,67 @@ cxxopts::Options parse_arguments(int argc, char **argv)
   cxxopts::Options options("simsync-cl", "A simple synchronization model.");
 
   options.add_options("help")("h,help", "Print this help message", cxxopts::value<bool>(), "");
-  options.add_options("input")("a,arch", "Architecture config", cxxopts::value<std::string>(), "<file>");
-  options.add_options("input")("t,trace", "Trace file", cxxopts::value<std::string>(), "<file>");
+  options.add_options("input")("a,arch", "Architecture config (a list or glob of configs to sweep)",
+      cxxopts::value<std::string>(), "<file>");
+  options.add_options("input")("scheduler",
+      "Scheduler policy (fifo, fastest-core, criticality, sticky), instead of the architecture config's",
+      cxxopts::value<std::string>(), "<string>");
+  options.add_options("input")("governor",
+      "Frequency governor (static, lock-boost, contention, ondemand), instead of the architecture config's",
+      cxxopts::value<std::string>(), "<string>");
+  options.add_options("input")("migration-penalty",
+      "Instructions to warm up a core a thread did not last run on, instead of the architecture config's",
+      cxxopts::value<int64_t>(), "<count>");
+  options.add_options("input")("timeslice", "Preempt threads after a time slice, instead of the architecture config's",
+      cxxopts::value<int64_t>(), "<ns>");
+  options.add_options("input")("context-switch",
+      "Time to switch a core to another thread, instead of the architecture config's", cxxopts::value<int64_t>(),
+      "<ns>");
+  options.add_options("input")("t,trace", "Trace file (a list of traces to schedule together)",
+      cxxopts::value<std::string>(), "<file>");
   options.add_options("output")("r,report", "Report type", cxxopts::value<std::string>(), "<string>");
   options.add_options("output")("o,out", "Output file", cxxopts::value<std::string>(), "<file>");
+  options.add_options("output")("replay", "Replay the happens-before graph on a list or glob of configs",
+      cxxopts::value<std::string>(), "<file>");
+  options.add_options("output")("validate", "Check the CPI sensitivity of this many threads by re-running",
+      cxxopts::value<size_t>()->default_value("0"), "<count>");
+  options.add_options("output")("step", "Relative change in CPI when checking CPI sensitivity",
+      cxxopts::value<double>()->default_value("0.01"), "<ratio>");
+  options.add_options("engine")("m,mode",
+      "Estimation mode (sequential, hybrid, phases, sampled, analytic, sweep, monte-carlo, "
+      "lock-elision, co-schedule)",
+      cxxopts::value<std::string>()->default_value("sequential"), "<string>");
+  options.add_options("engine")("j,jobs", "Worker threads, 0 for one per hardware thread",
+      cxxopts::value<size_t>()->default_value("0"), "<count>");
+  options.add_options("engine")("hot-rate", "Acquisitions per simulated microsecond above which hybrid mode "
+      "approximates a lock", cxxopts::value<double>()->default_value("10"), "<rate>");
+  options.add_options("engine")("hot-window", "Acquisitions of a lock in each window hybrid mode measures",
+      cxxopts::value<uint64_t>()->default_value("1000"), "<count>");
+  options.add_options("engine")("progress", "Seconds between progress lines, 0 for none",
+      cxxopts::value<double>()->default_value("10"), "<seconds>");
+  options.add_options("engine")("deadline", "Give up once the execution time is known to exceed this, 0 for no deadline",
+      cxxopts::value<int64_t>()->default_value("0"), "<ns>");
+  options.add_options("engine")("prune", "Give up on swept configs slower than the fastest so far",
+      cxxopts::value<bool>(), "");
+  options.add_options("engine")("bounds", "Print bounds on the execution time before simulating",
+      cxxopts::value<bool>(), "");
+  options.add_options("engine")("analytic", "Print the analytic estimate and its deviation from the simulation",
+      cxxopts::value<bool>(), "");
+  options.add_options("engine")("memoize", "Simulate repeated phases once", cxxopts::value<bool>(), "");
+  options.add_options("engine")("tolerance", "Relative difference in computation allowed between repeated phases",
+      cxxopts::value<double>()->default_value("0"), "<ratio>");
+  options.add_options("engine")("warmup", "Phases to simulate before sampling",
+      cxxopts::value<size_t>()->default_value("1"), "<count>");
+  options.add_options("engine")("samples", "Fewest phases to sample before extrapolating",
+      cxxopts::value<size_t>()->default_value("4"), "<count>");
+  options.add_options("engine")("confidence", "Extrapolate once the 95% CI of the sampled rate is within this ratio",
+      cxxopts::value<double>()->default_value("0.01"), "<ratio>");
+  options.add_options("engine")("top", "Locks to elide, most acquired first, 0 for all",
+      cxxopts::value<size_t>()->default_value("0"), "<count>");
+  options.add_options("engine")("replicates", "Replicates to simulate when sampling CPIs",
+      cxxopts::value<size_t>()->default_value("100"), "<count>");
+  options.add_options("engine")("seed", "Seed of the first replicate when sampling CPIs",
+      cxxopts::value<uint64_t>()->default_value("0"), "<number>");
 
   options.parse(argc, argv);
 
@@ -40,16 +117,77 @@ Stream load_file(std::string const &path)
   return file;
 }
 
+std::deque<std::string> split(std::string const &s, char delimiter = ',')
+{
+  std::deque<std::string> strings;
+  size_t start = 0;
+  size_t end = s.find(delimiter);
+
+  while(end != std::string::npos) {
+    strings.emplace_back(s.substr(start, end - start));
+    start = end + 1;
+    end = s.find(delimiter, start);
+  }
+
+  strings.emplace_back(s.substr(start, end));
+
+  return strings;
+}
+
+/**
+ * Load the applications to schedule together.
+ *
+ * @param traces A comma separated list of trace files, one per application.
+ *
+ * @return The applications.
+ */
+simsync::application load_application(std::string const &traces)
+{
+  std::deque<std::ifstream> files;
+  std::vector<std::istream *> streams;
+  for(auto const &path : split(traces)) {
+    files.push_back(load_file<std::ifstream>(path));
+    streams.push_back(&files.back());
+  }
+
+  return simsync::application(streams);
+}
+
 void validate(cxxopts::Options const &options)
 {
   if(options.count("t") == 0) {
     throw std::runtime_error("Missing Argument: Please provide an application trace.");
   }
-  load_file<std::ifstream>(options["t"].as<std::string>());
+  for(auto const &trace : split(options["t"].as<std::string>())) {
+    load_file<std::ifstream>(trace);
+  }
 
   if(options.count("a") == 0) {
     throw std::runtime_error("Missing Argument: Please provide an architecture configuration.");
   }
+
+  // sweeps, Monte Carlo estimates, lock elision and co-scheduling write a single table of results instead of reports
+  auto const mode = options["m"].as<std::string>();
+  // the modes that estimate many variants of the application, or do not simulate, have nothing to give up on
+  if(options["deadline"].as<int64_t>() > 0 &&
+      (mode == "analytic" || mode == "monte-carlo" || mode == "lock-elision" || mode == "co-schedule")) {
+    throw std::runtime_error("Error: --deadline is not supported in " + mode + " mode.");
+  }
+
+  // an analytic estimate has no reports
+  if(mode == "analytic") {
+    load_file<std::ifstream>(options["a"].as<std::string>());
+
+    return;
+  }
+
+  if(mode == "sweep" || mode == "monte-carlo" || mode == "lock-elision" || mode == "co-schedule") {
+    if(options.count("o") == 0) {
+      throw std::runtime_error("Missing Argument: Please provide an output file name.");
+    }
+
+    return;
+  }
   load_file<std::ifstream>(options["a"].as<std::string>());
 
   if(options.count("r") == 0) {
@@ -61,9 +199,40 @@ void validate(cxxopts::Options const &options)
   }
 }
 
+/**
+ * Use the scheduler policy, frequency governor, migration penalty, time slice and context switch cost chosen on the
+ * command line, if any.
+ *
+ * @param args The command line arguments.
+ * @param sys The system to schedule with them.
+ */
+void choose_scheduler(cxxopts::Options &args, simsync::system &sys)
+{
+  if(args.count("scheduler") > 0) {
+    sys.set_scheduler(simsync::make_scheduler_policy(args["scheduler"].as<std::string>()));
+  }
+  if(args.count("governor") > 0) {
+    sys.set_governor(simsync::make_frequency_governor(args["governor"].as<std::string>(), {}));
+  }
+  if(args.count("migration-penalty") > 0) {
+    sys.set_migration_penalty(args["migration-penalty"].as<int64_t>());
+  }
+
+  auto timeslice = sys.timeslice();
+  auto context_switch = sys.context_switch();
+  if(args.count("timeslice") > 0) {
+    timeslice = std::chrono::nanoseconds(args["timeslice"].as<int64_t>());
+  }
+  if(args.count("context-switch") > 0) {
+    context_switch = std::chrono::nanoseconds(args["context-switch"].as<int64_t>());
+  }
+  sys.set_preemption(timeslice, context_switch);
+}
+
 std::deque<std::unique_ptr<simsync::report>> create_reports(
     std::deque<std::string> const &report_types,
     std::deque<std::string> const &output_files,
+    simsync::application const &app,
     simsync::system &sys)
 {
   if(report_types.size() != output_files.size()) {
@@ -84,6 +253,16 @@ std::deque<std::unique_ptr<simsync::report>> create_reports(
       reports.emplace_back(std::make_unique<simsync::time_stack>(output_file, sys));
     } else if(report_type == "criticality-stack") {
       reports.emplace_back(std::make_unique<simsync::criticality_stack>(output_file, sys));
+    } else if(report_type == "happens-before") {
+      reports.emplace_back(std::make_unique<simsync::happens_before>(output_file, app, sys));
+    } else if(report_type == "completion-time") {
+      reports.emplace_back(std::make_unique<simsync::completion_time>(output_file));
+    } else if(report_type == "cpi-sensitivity") {
+      reports.emplace_back(std::make_unique<simsync::cpi_sensitivity>(output_file, app, sys));
+    } else if(report_type == "energy") {
+      reports.emplace_back(std::make_unique<simsync::energy_use>(output_file, sys));
+    } else if(report_type == "migrations") {
+      reports.emplace_back(std::make_unique<simsync::migrations>(output_file, sys));
     } else {
       throw std::runtime_error("Error: Unknown report type specified.");
     }
@@ -92,21 +271,341 @@ std::deque<std::unique_ptr<simsync::report>> create_reports(
   return reports;
 }
 
-std::deque<std::string> split(std::string const &s, char delimiter = ',')
+std::vector<std::string> expand_configs(std::string const &patterns)
 {
-  std::deque<std::string> strings;
-  size_t start = 0;
-  size_t end = s.find(delimiter);
+  std::vector<std::string> configs;
 
-  while(end != std::string::npos) {
-    strings.emplace_back(s.substr(start, end - start));
-    start = end + 1;
-    end = s.find(delimiter, start);
+  for(auto const &pattern : split(patterns)) {
+    glob_t matches;
+    if(glob(pattern.c_str(), 0, nullptr, &matches) != 0) {
+      globfree(&matches);
+      throw std::runtime_error("Error: " + pattern + " does not exist.");
+    }
+
+    for(size_t index = 0; index < matches.gl_pathc; ++index) {
+      configs.emplace_back(matches.gl_pathv[index]);
+    }
+    globfree(&matches);
   }
 
-  strings.emplace_back(s.substr(start, end));
+  return configs;
+}
 
-  return strings;
+void validate_sensitivity(cxxopts::Options &args,
+    simsync::cpi_sensitivity const &sensitivity,
+    simsync::application const &app,
+    std::string const &config,
+    size_t count,
+    double step)
+{
+  using namespace std::chrono;
+
+  // check the threads the execution time is most sensitive to
+  auto const critical_time = sensitivity.critical_time();
+  std::vector<std::pair<int32_t, simsync::picoseconds>> threads(critical_time.begin(), critical_time.end());
+  std::sort(threads.begin(), threads.end(), [](auto const &a, auto const &b) { return a.second > b.second; });
+  threads.resize(std::min(count, threads.size()));
+
+  std::vector<nanoseconds> times(threads.size());
+  simsync::parallel_for(threads.size(), 0, [&](size_t const index) {
+    simsync::architecture arch(config);
+    arch.scale_cpi_rate(threads[index].first, 1.0 + step);
+    simsync::system sys(config, arch);
+    choose_scheduler(args, sys);
+
+    times[index] = simsync::estimate(app, sys, {});
+  });
+
+  auto const total_time = duration_cast<nanoseconds>(sensitivity.total_time());
+  for(size_t index = 0; index < threads.size(); ++index) {
+    auto const predicted = duration<double, std::nano>(threads[index].second).count();
+    auto const measured = (times[index] - total_time).count() / step;
+
+    std::cout << "Info: Thread " << threads[index].first << " CPI sensitivity is " << predicted
+              << "ns, finite difference is " << measured << "ns\n";
+  }
+}
+
+void replay(simsync::happens_before const &graph, std::string const &patterns)
+{
+  using namespace std::chrono;
+
+  for(auto const &config : expand_configs(patterns)) {
+    simsync::architecture arch(config);
+    simsync::system sys(config, arch);
+
+    auto const start = high_resolution_clock::now();
+    auto const result = graph.replay(arch, sys);
+    auto const end = high_resolution_clock::now();
+
+    std::cout << "Info: Replay on " << config << " estimates " << duration<double>(result.execution_time).count()
+              << "s with " << result.reordered_locks << " reordered lock requests, in "
+              << duration<double, std::milli>(end - start).count() << "ms\n";
+  }
+}
+
+int sweep(cxxopts::Options &args)
+{
+  using namespace std::chrono;
+
+  auto const configs = expand_configs(args["a"].as<std::string>());
+  std::cout << "Info: " << args["o"].as<std::string>() << "\n";
+  std::cout << "Info: Sweeping " << configs.size() << " architecture configs\n";
+
+  auto start = high_resolution_clock::now();
+  auto const application = load_application(args["t"].as<std::string>());
+  auto end = high_resolution_clock::now();
+  std::cout << "Perf: Application trace loaded in "
+            << std::chrono::duration<double, std::milli>(end - start).count() << "ms\n";
+
+  start = high_resolution_clock::now();
+  simsync::sweep_options options;
+  options.workers = args["j"].as<size_t>();
+  options.deadline = std::chrono::nanoseconds(args["deadline"].as<int64_t>());
+  options.prune = args.count("prune") > 0;
+  if(args.count("scheduler") > 0) {
+    options.scheduler = args["scheduler"].as<std::string>();
+  }
+  if(args.count("governor") > 0) {
+    options.governor = args["governor"].as<std::string>();
+  }
+  if(args.count("migration-penalty") > 0) {
+    options.migration_penalty = args["migration-penalty"].as<int64_t>();
+  }
+  if(args.count("timeslice") > 0) {
+    options.timeslice = std::chrono::nanoseconds(args["timeslice"].as<int64_t>());
+  }
+  if(args.count("context-switch") > 0) {
+    options.context_switch = std::chrono::nanoseconds(args["context-switch"].as<int64_t>());
+  }
+
+  auto const results = simsync::sweep(application, configs, options);
+  end = high_resolution_clock::now();
+  std::cout << "Perf: Sweep completed in " << std::chrono::duration<double, std::milli>(end - start).count()
+            << "ms\n";
+
+  std::ofstream table(args["o"].as<std::string>());
+  table << "config,cores,execution time,complete\n";
+  for(auto const &r : results) {
+    table << r.config << "," << r.cores << "," << r.execution_time.count() << "," << r.complete << "\n";
+  }
+
+  return EXIT_SUCCESS;
+}
+
+int monte_carlo(cxxopts::Options &args)
+{
+  using namespace std::chrono;
+
+  std::cout << "Info: " << args["o"].as<std::string>() << "\n";
+
+  auto start = high_resolution_clock::now();
+  simsync::architecture architecture(args["a"].as<std::string>());
+  simsync::system system(args["a"].as<std::string>(), architecture);
+  choose_scheduler(args, system);
+  auto end = high_resolution_clock::now();
+  std::cout << "Perf: Timing model loaded in "
+            << std::chrono::duration<double, std::milli>(end - start).count() << "ms\n";
+
+  start = high_resolution_clock::now();
+  auto const application = load_application(args["t"].as<std::string>());
+  end = high_resolution_clock::now();
+  std::cout << "Perf: Application trace loaded in "
+            << std::chrono::duration<double, std::milli>(end - start).count() << "ms\n";
+
+  start = high_resolution_clock::now();
+  simsync::monte_carlo_options options;
+  options.replicates = args["replicates"].as<size_t>();
+  options.seed = args["seed"].as<uint64_t>();
+  options.workers = args["j"].as<size_t>();
+
+  auto const result = simsync::estimate_replicates(application, system, options);
+  end = high_resolution_clock::now();
+  std::cout << "Perf: " << options.replicates << " replicates completed in "
+            << std::chrono::duration<double, std::milli>(end - start).count() << "ms\n";
+
+  if(options.replicates > 0) {
+    std::cout << "Info: SimSync mean execution time estimate is " << duration<double>(result.mean).count()
+              << "s, 95% CI " << duration<double>(result.confidence_lower).count() << "s to "
+              << duration<double>(result.confidence_upper).count() << "s\n";
+    std::cout << "Info: Percentiles p5 " << duration<double>(simsync::percentile(result, 0.05)).count() << "s, p50 "
+              << duration<double>(simsync::percentile(result, 0.5)).count() << "s, p95 "
+              << duration<double>(simsync::percentile(result, 0.95)).count() << "s\n";
+  }
+
+  std::ofstream table(args["o"].as<std::string>());
+  table << "seed,execution time\n";
+  for(size_t replicate = 0; replicate < result.execution_times.size(); ++replicate) {
+    table << options.seed + replicate << "," << result.execution_times[replicate].count() << "\n";
+  }
+
+  return EXIT_SUCCESS;
+}
+
+int lock_elision(cxxopts::Options &args)
+{
+  using namespace std::chrono;
+
+  std::cout << "Info: " << args["o"].as<std::string>() << "\n";
+
+  auto start = high_resolution_clock::now();
+  simsync::architecture architecture(args["a"].as<std::string>());
+  simsync::system system(args["a"].as<std::string>(), architecture);
+  choose_scheduler(args, system);
+  auto const application = load_application(args["t"].as<std::string>());
+  auto end = high_resolution_clock::now();
+  std::cout << "Perf: Inputs loaded in " << std::chrono::duration<double, std::milli>(end - start).count() << "ms\n";
+
+  start = high_resolution_clock::now();
+  simsync::lock_elision_options options;
+  options.top = args["top"].as<size_t>();
+  options.workers = args["j"].as<size_t>();
+
+  nanoseconds baseline(0);
+  auto const results = simsync::estimate_lock_elision(application, system, options, &baseline);
+  end = high_resolution_clock::now();
+  std::cout << "Perf: " << results.size() << " locks elided in "
+            << std::chrono::duration<double, std::milli>(end - start).count() << "ms\n";
+  std::cout << "Info: SimSync execution time estimate is " << std::chrono::duration<double>(baseline).count()
+            << "s\n";
+
+  std::ofstream table(args["o"].as<std::string>());
+  table << "lock,acquisitions,execution time,speedup\n";
+  for(auto const &r : results) {
+    table << r.lock << "," << r.acquisitions << "," << r.execution_time.count() << "," << r.speedup << "\n";
+  }
+
+  return EXIT_SUCCESS;
+}
+
+int co_schedule(cxxopts::Options &args)
+{
+  using namespace std::chrono;
+
+  std::cout << "Info: " << args["o"].as<std::string>() << "\n";
+
+  auto start = high_resolution_clock::now();
+  simsync::architecture architecture(args["a"].as<std::string>());
+  simsync::system system(args["a"].as<std::string>(), architecture);
+  choose_scheduler(args, system);
+  auto const application = load_application(args["t"].as<std::string>());
+  auto end = high_resolution_clock::now();
+  std::cout << "Perf: Inputs loaded in " << std::chrono::duration<double, std::milli>(end - start).count() << "ms\n";
+
+  start = high_resolution_clock::now();
+  auto const results = simsync::co_schedule(application, system, args["j"].as<size_t>());
+  end = high_resolution_clock::now();
+  std::cout << "Perf: " << results.size() << " applications co-scheduled in "
+            << std::chrono::duration<double, std::milli>(end - start).count() << "ms\n";
+
+  auto const traces = split(args["t"].as<std::string>());
+  std::ofstream table(args["o"].as<std::string>());
+  table << "application,trace,alone,together,slowdown\n";
+  for(size_t index = 0; index < results.size(); ++index) {
+    auto const &r = results[index];
+    table << index << "," << traces[index] << "," << r.alone.count() << "," << r.together.count() << ","
+          << r.slowdown << "\n";
+  }
+
+  return EXIT_SUCCESS;
+}
+
+int analytic(cxxopts::Options &args)
+{
+  using namespace std::chrono;
+
+  auto start = high_resolution_clock::now();
+  simsync::architecture architecture(args["a"].as<std::string>());
+  simsync::system system(args["a"].as<std::string>(), architecture);
+  auto const application = load_application(args["t"].as<std::string>());
+  auto end = high_resolution_clock::now();
+  std::cout << "Perf: Inputs loaded in " << std::chrono::duration<double, std::milli>(end - start).count() << "ms\n";
+
+  start = high_resolution_clock::now();
+  auto const execution_time = simsync::estimate_analytic(application, system);
+  end = high_resolution_clock::now();
+  std::cout << "Perf: Estimation completed in "
+            << std::chrono::duration<double, std::milli>(end - start).count() << "ms\n";
+
+  std::cout << "Info: SimSync analytic execution time estimate is "
+            << std::chrono::duration<double>(execution_time).count() << "s\n";
+
+  return EXIT_SUCCESS;
+}
+
+// the simulation to cancel on an interrupt
+simsync::simulation *running_simulation = nullptr;
+
+extern "C" void cancel_simulation(int)
+{
+  if(running_simulation != nullptr) {
+    running_simulation->cancel();
+  }
+}
+
+/**
+ * Run a simulation, with the engine specialized for the reports if it was compiled for them.
+ *
+ * @param sim The simulation to run.
+ * @param reports The reports to generate, which are the simulation's reports.
+ *
+ * @return the time of the last event processed.
+ */
+std::chrono::nanoseconds run_specialized(
+    simsync::simulation &sim, std::deque<std::unique_ptr<simsync::report>> const &reports)
+{
+  simsync::time_stack *times = nullptr;
+  simsync::criticality_stack *criticality = nullptr;
+  for(auto const &r : reports) {
+    times = times == nullptr ? dynamic_cast<simsync::time_stack *>(r.get()) : times;
+    criticality = criticality == nullptr ? dynamic_cast<simsync::criticality_stack *>(r.get()) : criticality;
+  }
+
+  auto const matched = (times != nullptr ? 1u : 0u) + (criticality != nullptr ? 1u : 0u);
+  if(matched != reports.size()) {
+    return sim.run();
+  }
+
+  if(times != nullptr && criticality != nullptr) {
+    simsync::report_set<simsync::time_stack, simsync::criticality_stack> set(*times, *criticality);
+    return sim.run(set);
+  } else if(times != nullptr) {
+    simsync::report_set<simsync::time_stack> set(*times);
+    return sim.run(set);
+  } else {
+    simsync::report_set<simsync::criticality_stack> set(*criticality);
+    return sim.run(set);
+  }
+}
+
+std::chrono::nanoseconds run_sequential(simsync::application const &app,
+    simsync::system &sys,
+    std::deque<std::unique_ptr<simsync::report>> const &reports,
+    double progress_interval)
+{
+  simsync::simulation sim(app, sys, reports);
+
+  if(progress_interval > 0) {
+    sim.on_progress(
+        [](simsync::progress const &p) {
+          std::cout << "Perf: Processed " << p.events << " events, "
+                    << std::chrono::duration<double>(p.time).count() << "s simulated, at " << p.events_per_second
+                    << " events/s" << std::endl;
+        },
+        std::chrono::milliseconds(static_cast<int64_t>(progress_interval * 1000)));
+  }
+
+  running_simulation = &sim;
+  auto const previous_handler = std::signal(SIGINT, cancel_simulation);
+  auto const execution_time = run_specialized(sim, reports);
+  std::signal(SIGINT, previous_handler);
+  running_simulation = nullptr;
+
+  if(sim.cancelled()) {
+    std::cout << "Info: Simulation cancelled after " << sim.events() << " events\n";
+  }
+
+  return execution_time;
 }
 
 int main(int argc, char **argv)
@@ -116,34 +615,119 @@ int main(int argc, char **argv)
   try {
     auto args = parse_arguments(argc, argv);
     if(args.count("h") == 1) {
-      std::cout << args.help({"help", "input", "output"});
+      std::cout << args.help({"help", "input", "output", "engine"});
 
       return EXIT_SUCCESS;
     }
 
     validate(args);
+    if(args["m"].as<std::string>() == "sweep") {
+      return sweep(args);
+    } else if(args["m"].as<std::string>() == "monte-carlo") {
+      return monte_carlo(args);
+    } else if(args["m"].as<std::string>() == "lock-elision") {
+      return lock_elision(args);
+    } else if(args["m"].as<std::string>() == "co-schedule") {
+      return co_schedule(args);
+    } else if(args["m"].as<std::string>() == "analytic") {
+      return analytic(args);
+    }
+
     std::cout << "Info: " << args["o"].as<std::string>() << "\n";
     std::cout << "Info: " << args["r"].as<std::string>() << "\n";
 
     auto start = high_resolution_clock::now();
     simsync::architecture architecture(args["a"].as<std::string>());
     simsync::system system(args["a"].as<std::string>(), architecture);
+    choose_scheduler(args, system);
     auto end = high_resolution_clock::now();
     std::cout << "Perf: Timing model loaded in "
               << std::chrono::duration<double, std::milli>(end - start).count() << "ms\n";
 
     start = high_resolution_clock::now();
-    auto trace = load_file<std::ifstream>(args["t"].as<std::string>());
-    simsync::application application(trace);
+    auto const application = load_application(args["t"].as<std::string>());
     end = high_resolution_clock::now();
     std::cout << "Perf: Application trace loaded in "
               << std::chrono::duration<double, std::milli>(end - start).count() << "ms\n";
 
     auto reports = create_reports(
-        split(args["r"].as<std::string>()), split(args["o"].as<std::string>()), system);
+        split(args["r"].as<std::string>()), split(args["o"].as<std::string>()), application, system);
+
+    if(args.count("bounds") > 0) {
+      auto const b = simsync::estimate_bounds(application, system);
+      std::cout << "Info: SimSync execution time bounds are " << std::chrono::duration<double>(b.lower).count()
+                << "s to ";
+      if(b.upper == std::chrono::nanoseconds::max()) {
+        std::cout << "unbounded\n";
+      } else {
+        std::cout << std::chrono::duration<double>(b.upper).count() << "s\n";
+      }
+    }
 
     start = high_resolution_clock::now();
-    auto const execution_time = simsync::estimate(application, system, reports);
+    auto const mode = args["m"].as<std::string>();
+    auto const deadline = std::chrono::nanoseconds(args["deadline"].as<int64_t>());
+    // the other modes skip an application that cannot finish by the deadline, as sequential mode does before it
+    // stops at the deadline
+    auto const bounded = mode == "hybrid" || mode == "phases" || mode == "sampled";
+    auto const lower_bound = deadline.count() > 0 && bounded ? simsync::estimate_bounds(application, system).lower
+                                                             : std::chrono::nanoseconds(0);
+    std::chrono::nanoseconds execution_time;
+    if(lower_bound > deadline) {
+      execution_time = lower_bound;
+      std::cout << "Info: Simulation skipped, as the lower bound exceeds the deadline\n";
+    } else if(mode == "sequential" && deadline.count() > 0) {
+      execution_time = simsync::estimate(application, system, reports, deadline);
+      if(execution_time > deadline) {
+        std::cout << "Info: Simulation stopped at the deadline\n";
+      }
+    } else if(mode == "sequential") {
+      execution_time = run_sequential(application, system, reports, args["progress"].as<double>());
+    } else if(mode == "hybrid") {
+      simsync::hot_lock_summary summary;
+
+      simsync::hot_lock_options options;
+      options.rate = args["hot-rate"].as<double>();
+      options.window = args["hot-window"].as<uint64_t>();
+      options.summary = &summary;
+
+      execution_time = simsync::estimate(application, system, reports, options);
+      std::cout << "Info: Approximated " << summary.acquisitions << " acquisitions of " << summary.locks
+                << " locks, waiting " << std::chrono::duration<double>(summary.wait).count() << "s over "
+                << std::chrono::duration<double>(summary.duration).count() << "s of approximated lock time, with "
+                << summary.fallbacks << " fallbacks to exact simulation\n";
+    } else if(mode == "phases") {
+      size_t phases = 0;
+      size_t simulated = 0;
+
+      simsync::phase_options options;
+      options.workers = args["j"].as<size_t>();
+      options.memoize = args.count("memoize") > 0;
+      options.tolerance = args["tolerance"].as<double>();
+      options.phases = &phases;
+      options.simulated = &simulated;
+
+      execution_time = simsync::estimate_phases(application, system, reports, options);
+      std::cout << "Info: Simulated " << simulated << " of " << phases << " phases\n";
+    } else if(mode == "sampled") {
+      size_t phases = 0;
+      size_t simulated = 0;
+      std::chrono::nanoseconds error(0);
+
+      simsync::sampling_options options;
+      options.warmup = args["warmup"].as<size_t>();
+      options.samples = args["samples"].as<size_t>();
+      options.confidence = args["confidence"].as<double>();
+      options.error = &error;
+      options.phases = &phases;
+      options.simulated = &simulated;
+
+      execution_time = simsync::estimate_sampled(application, system, reports, options);
+      std::cout << "Info: Simulated " << simulated << " of " << phases << " phases, extrapolated with an error of "
+                << std::chrono::duration<double>(error).count() << "s\n";
+    } else {
+      throw std::runtime_error("Error: Unknown estimation mode specified.");
+    }
     end = high_resolution_clock::now();
     std::cout << "Perf: Estimation completed in "
               << std::chrono::duration<double, std::milli>(end - start).count() << "ms\n";
@@ -151,6 +735,28 @@ int main(int argc, char **argv)
     std::cout << "Info: SimSync execution time estimate is "
               << std::chrono::duration<double>(execution_time).count() << "s\n";
 
+    if(args.count("analytic") > 0) {
+      auto const analytic_time = simsync::estimate_analytic(application, system);
+      auto const deviation = 100.0 * (static_cast<double>(analytic_time.count()) - execution_time.count())
+                             / std::max<double>(static_cast<double>(execution_time.count()), 1.0);
+      std::cout << "Info: SimSync analytic execution time estimate is "
+                << std::chrono::duration<double>(analytic_time).count() << "s (" << deviation << "% deviation)\n";
+    }
+
+    auto const validate_count = args["validate"].as<size_t>();
+    for(auto const &r : reports) {
+      auto const graph = dynamic_cast<simsync::happens_before const *>(r.get());
+      if(graph != nullptr && args.count("replay") > 0) {
+        replay(*graph, args["replay"].as<std::string>());
+      }
+
+      auto const sensitivity = dynamic_cast<simsync::cpi_sensitivity const *>(r.get());
+      if(sensitivity != nullptr && validate_count > 0) {
+        validate_sensitivity(args, *sensitivity, application, args["a"].as<std::string>(), validate_count,
+            args["step"].as<double>());
+      }
+    }
+
   } catch(std::exception const &e) {
     std::cerr << e.what() << "\n";
     return EXIT_FAILURE;
@@ -0,0 +1,875 @@
+#include <simsync/application.hpp>
+#include <simsync/architecture.hpp>
+#include <simsync/bounds.hpp>
+#include <simsync/checkpoint.hpp>
+#include <simsync/co_schedule.hpp>
+#include <simsync/core.hpp>
+#include <simsync/estimate.hpp>
+#include <simsync/frequency_governor.hpp>
+#include <simsync/hot_locks.hpp>
+#include <simsync/lock_elision.hpp>
+#include <simsync/monte_carlo.hpp>
+#include <simsync/scheduler_policy.hpp>
+#include <simsync/simulation.hpp>
+#include <simsync/sweep.hpp>
+#include <simsync/system.hpp>
+#include <simsync/thread_tracker.hpp>
+#include <simsync/reports/cpi_sensitivity.hpp>
+#include <simsync/reports/energy_use.hpp>
+#include <simsync/reports/happens_before.hpp>
+#include <simsync/synchronization/event.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * An architecture and the system running on it, loaded from the same config.
+ */
+struct machine {
+  explicit machine(std::string const &config_file) : arch(config_file), sys(config_file, arch)
+  {
+  }
+
+  simsync::architecture arch;
+  simsync::system sys;
+};
+
+/**
+ * A system configuration the estimation modes are compared on.
+ */
+struct variant {
+  std::string name;
+  std::string config;
+  std::function<void(simsync::system &)> configure;
+};
+
+/**
+ * The application and the data directory shared by the tests.
+ */
+struct fixture {
+  std::string data;
+  std::unique_ptr<simsync::application> app;
+  std::vector<variant> variants;
+
+  std::unique_ptr<machine> load(variant const &v) const
+  {
+    auto m = std::make_unique<machine>(data + "/" + v.config);
+    v.configure(m->sys);
+
+    return m;
+  }
+};
+
+using reports = std::deque<std::unique_ptr<simsync::report>>;
+
+/**
+ * Records the core each thread processed its first event on, and counts the times it processed an event on a different
+ * core than its previous event.
+ */
+class core_changes : public simsync::report {
+public:
+  explicit core_changes(simsync::system const &sys) : report("/dev/null"), m_system(sys)
+  {
+  }
+
+  void update(simsync::picoseconds, simsync::event *e) override
+  {
+    auto const thread_id = e->get_thread_id();
+    auto const core_id = m_system.get_thread_core_id(thread_id);
+
+    auto const last = m_last_core.find(thread_id);
+    if(last == m_last_core.end()) {
+      first_core[thread_id] = core_id;
+    } else if(last->second != core_id) {
+      ++changes[thread_id];
+    }
+    m_last_core[thread_id] = core_id;
+  }
+
+  std::map<int32_t, size_t> first_core;
+  std::map<int32_t, size_t> changes;
+
+private:
+  simsync::system const &m_system;
+
+  std::map<int32_t, size_t> m_last_core;
+};
+
+/**
+ * Counts the scheduler ticks that preempted a thread.
+ */
+class preemption_count : public simsync::report {
+public:
+  preemption_count() : report("/dev/null")
+  {
+  }
+
+  void update(simsync::picoseconds, simsync::event *) override
+  {
+  }
+
+  void preempt(simsync::picoseconds) override
+  {
+    ++preemptions;
+  }
+
+  size_t preemptions = 0;
+};
+
+void expect(bool const condition, std::string const &what)
+{
+  if(!condition) {
+    throw std::runtime_error(what);
+  }
+}
+
+void expect_equal(
+    std::chrono::nanoseconds const actual, std::chrono::nanoseconds const expected, std::string const &what)
+{
+  expect(actual == expected,
+      what + ": " + std::to_string(actual.count()) + "ns, expected " + std::to_string(expected.count()) + "ns");
+}
+
+std::function<void(simsync::system &)> governed(std::string const &name)
+{
+  return [name](simsync::system &sys) {
+    simsync::governor_options options;
+    // short windows, so the ondemand governor changes levels within the trace
+    options.window = std::chrono::microseconds(100);
+    sys.set_governor(simsync::make_frequency_governor(name, options));
+  };
+}
+
+std::vector<variant> make_variants()
+{
+  auto const unchanged = [](simsync::system &) {};
+  auto const migrating = [](simsync::system &sys) {
+    sys.set_scheduler(simsync::make_scheduler_policy("sticky"));
+    sys.set_migration_penalty(20000);
+  };
+  auto const preempting = [](simsync::system &sys) {
+    sys.set_preemption(std::chrono::microseconds(50), std::chrono::microseconds(1));
+  };
+
+  return {
+      {"static", "cores6.json", unchanged},
+      {"lock-boost", "cores6.json", governed("lock-boost")},
+      {"contention", "cores6.json", governed("contention")},
+      {"ondemand", "cores6.json", governed("ondemand")},
+      {"criticality", "cores6.json",
+          [](simsync::system &sys) { sys.set_scheduler(simsync::make_scheduler_policy("criticality")); }},
+      {"migration", "cores6.json", migrating},
+      {"affinity", "pinned6.json", unchanged},
+      {"affinity with migration", "pinned6.json", migrating},
+      {"siblings", "siblings6.json", unchanged},
+      {"siblings with ondemand", "siblings6.json", governed("ondemand")},
+      {"oversubscribed", "cores2.json", unchanged},
+      {"oversubscribed with criticality", "cores2.json",
+          [](simsync::system &sys) { sys.set_scheduler(simsync::make_scheduler_policy("criticality")); }},
+      {"preemption", "cores2.json", preempting},
+      {"preemption with ondemand", "cores2.json",
+          [=](simsync::system &sys) {
+            preempting(sys);
+            governed("ondemand")(sys);
+          }},
+  };
+}
+
+std::chrono::nanoseconds sequential(fixture const &f, variant const &v)
+{
+  auto m = f.load(v);
+
+  return simsync::estimate(*f.app, m->sys, reports{});
+}
+
+void hybrid_matches_sequential(fixture const &f)
+{
+  for(auto const &v : f.variants) {
+    // no lock is acquired often enough to be approximated
+    simsync::hot_lock_options options;
+    options.rate = 1e9;
+
+    auto m = f.load(v);
+    auto const time = simsync::estimate(*f.app, m->sys, reports{}, options);
+    expect_equal(time, sequential(f, v), v.name);
+  }
+}
+
+void phases_match_sequential(fixture const &f)
+{
+  // the systems with a thread per core of one type that keep no state between phases
+  std::set<std::string> const splittable{"static", "lock-boost", "contention", "criticality"};
+
+  for(auto const &v : f.variants) {
+    size_t phases = 0;
+    size_t simulated = 0;
+
+    simsync::phase_options options;
+    options.workers = 2;
+    options.phases = &phases;
+    options.simulated = &simulated;
+
+    auto m = f.load(v);
+    auto const time = simsync::estimate_phases(*f.app, m->sys, reports{}, options);
+    expect_equal(time, sequential(f, v), v.name);
+
+    if(splittable.count(v.name) > 0) {
+      expect(phases > 1, v.name + ": the trace was not split into phases");
+      expect(simulated == phases, v.name + ": " + std::to_string(simulated) + " of " + std::to_string(phases)
+                                      + " phases were simulated without memoization");
+    } else {
+      expect(phases == 1, v.name + ": the trace was split although phases depend on each other");
+    }
+  }
+}
+
+void sampled_matches_sequential(fixture const &f)
+{
+  for(auto const &v : f.variants) {
+    // the confidence interval never gets this narrow, so every phase is simulated
+    simsync::sampling_options options;
+    options.confidence = 0.0;
+
+    auto m = f.load(v);
+    auto const time = simsync::estimate_sampled(*f.app, m->sys, reports{}, options);
+    expect_equal(time, sequential(f, v), v.name);
+  }
+}
+
+void resume_matches_sequential(fixture const &f)
+{
+  for(auto const sampled : {false, true}) {
+    for(auto const &v : f.variants) {
+      auto const name = v.name + (sampled ? " with sampled CPIs" : "");
+
+      std::deque<std::unique_ptr<simsync::checkpoint>> checkpoints;
+      simsync::checkpoint_options options;
+      options.events = 40;
+      options.checkpoints = &checkpoints;
+
+      std::chrono::nanoseconds expected(0);
+      {
+        auto m = f.load(v);
+        reports none;
+        simsync::simulation sim(*f.app, m->sys, none);
+        if(sampled) {
+          sim.sample_cpi(7);
+        }
+        sim.take_checkpoints(options);
+        expected = sim.run();
+      }
+      expect(!checkpoints.empty(), name + ": no checkpoints were taken");
+
+      // the original simulation and its system are gone, so the checkpoints must stand on their own
+      for(auto const &from : checkpoints) {
+        auto m = f.load(v);
+        reports none;
+        simsync::simulation sim(*f.app, *from, m->sys, none);
+        expect_equal(sim.run(), expected, name + " from event " + std::to_string(from->events()));
+      }
+    }
+  }
+}
+
+double total_energy(simsync::system const &sys, std::chrono::nanoseconds const until)
+{
+  auto const totals = sys.energy(until);
+
+  return std::accumulate(totals.cores.begin(), totals.cores.end(), 0.0);
+}
+
+void resume_keeps_energy(fixture const &f)
+{
+  for(auto const &governor : {"static", "contention", "ondemand"}) {
+    std::deque<std::unique_ptr<simsync::checkpoint>> checkpoints;
+    simsync::checkpoint_options options;
+    options.events = 40;
+    options.checkpoints = &checkpoints;
+
+    machine original(f.data + "/power6.json");
+    governed(governor)(original.sys);
+    std::chrono::nanoseconds time(0);
+    {
+      reports none;
+      simsync::simulation sim(*f.app, original.sys, none);
+      sim.take_checkpoints(options);
+      time = sim.run();
+    }
+    auto const expected = total_energy(original.sys, time);
+
+    for(auto const &from : checkpoints) {
+      machine m(f.data + "/power6.json");
+      governed(governor)(m.sys);
+      reports none;
+      simsync::simulation sim(*f.app, *from, m.sys, none);
+      sim.run();
+
+      auto const energy = total_energy(m.sys, time);
+      expect(std::abs(energy - expected) <= 1e-9 * expected,
+          std::string(governor) + " from event " + std::to_string(from->events()) + ": used "
+              + std::to_string(energy) + "J, expected " + std::to_string(expected) + "J");
+    }
+  }
+}
+
+void replay_matches_sequential(fixture const &f)
+{
+  auto const &v = f.variants.front();
+  auto m = f.load(v);
+
+  reports captured;
+  captured.emplace_back(std::make_unique<simsync::happens_before>("/dev/null", *f.app, m->sys));
+  auto const expected = simsync::estimate(*f.app, m->sys, captured);
+
+  auto const &graph = static_cast<simsync::happens_before const &>(*captured.front());
+  auto const result = graph.replay(m->arch, m->sys);
+  expect_equal(result.execution_time, expected, v.name);
+  expect(result.reordered_locks == 0, v.name + ": locks were reordered on the captured config");
+}
+
+void replay_rejects_migration_penalties(fixture const &f)
+{
+  for(auto const &v : f.variants) {
+    auto m = f.load(v);
+    if(m->sys.migration_penalty() == 0) {
+      continue;
+    }
+
+    reports captured;
+    captured.emplace_back(std::make_unique<simsync::happens_before>("/dev/null", *f.app, m->sys));
+    simsync::estimate(*f.app, m->sys, captured);
+
+    auto const &graph = static_cast<simsync::happens_before const &>(*captured.front());
+    bool rejected = false;
+    try {
+      graph.replay(m->arch, m->sys);
+    } catch(std::runtime_error const &) {
+      rejected = true;
+    }
+    expect(rejected, v.name + ": the replay ignored migration penalties");
+  }
+}
+
+void bounds_contain_sequential(fixture const &f)
+{
+  for(auto const &v : f.variants) {
+    auto m = f.load(v);
+    auto const b = simsync::estimate_bounds(*f.app, m->sys);
+    auto const time = sequential(f, v);
+
+    expect(b.lower <= time, v.name + ": the lower bound exceeds the execution time");
+    expect(time <= b.upper, v.name + ": the execution time exceeds the upper bound");
+  }
+}
+
+void deadline_does_not_skip(fixture const &f)
+{
+  for(auto const &v : f.variants) {
+    auto const expected = sequential(f, v);
+
+    // a deadline just after the execution time must not give up early
+    auto m = f.load(v);
+    auto const time = simsync::estimate(*f.app, m->sys, reports{}, expected + std::chrono::nanoseconds(1));
+    expect_equal(time, expected, v.name);
+
+    // a deadline the application cannot meet gives up at the deadline, or at the lower bound if that is later
+    auto early = f.load(v);
+    auto const lower = simsync::estimate_bounds(*f.app, early->sys).lower;
+    auto const deadline = lower / 2;
+    auto const given_up = simsync::estimate(*f.app, early->sys, reports{}, deadline);
+    expect(given_up > deadline && given_up <= expected, v.name + ": gave up at the wrong time");
+  }
+}
+
+variant const &find_variant(fixture const &f, std::string const &name)
+{
+  for(auto const &v : f.variants) {
+    if(v.name == name) {
+      return v;
+    }
+  }
+
+  throw std::runtime_error("no variant named " + name);
+}
+
+void migrations_are_counted(fixture const &f)
+{
+  // without preemption, a thread keeps its core from when it starts executing until it stops after an event
+  for(auto const &name : {"static", "oversubscribed", "migration", "affinity"}) {
+    auto const &v = find_variant(f, name);
+    auto m = f.load(v);
+
+    reports observed;
+    observed.emplace_back(std::make_unique<core_changes>(m->sys));
+    simsync::estimate(*f.app, m->sys, observed);
+
+    auto const &changes = static_cast<core_changes const &>(*observed.front()).changes;
+    expect(m->sys.migrations() == changes, v.name + ": the migrations do not match the changes of core");
+
+    // the sticky policy keeps threads on their last core while it is free, and there is a core per thread
+    if(name == std::string("migration")) {
+      expect(changes.empty(), v.name + ": threads migrated while their last core was free");
+    } else {
+      expect(!changes.empty(), v.name + ": no thread migrated");
+    }
+  }
+}
+
+void fastest_core_is_chosen(fixture const &f)
+{
+  // the main thread starts alone, with the 1 GHz core listed before the 2 GHz one
+  for(auto const &policy : {"fifo", "fastest-core"}) {
+    machine m(f.data + "/mixed2.json");
+    m.sys.set_scheduler(simsync::make_scheduler_policy(policy));
+
+    reports observed;
+    observed.emplace_back(std::make_unique<core_changes>(m.sys));
+    simsync::estimate(*f.app, m.sys, observed);
+
+    auto const main_thread = f.app->threads().begin()->first;
+    auto const core_id = static_cast<core_changes const &>(*observed.front()).first_core.at(main_thread);
+    size_t const expected = policy == std::string("fifo") ? 0 : 1;
+    expect(core_id == expected, std::string(policy) + ": the main thread started on core " + std::to_string(core_id));
+  }
+}
+
+void preemption_switches_threads(fixture const &f)
+{
+  for(auto const &name : {"preemption", "static"}) {
+    auto const &v = find_variant(f, name);
+    auto m = f.load(v);
+    m->sys.set_preemption(std::chrono::microseconds(50), std::chrono::microseconds(1));
+
+    reports counted;
+    counted.emplace_back(std::make_unique<preemption_count>());
+    simsync::estimate(*f.app, m->sys, counted);
+
+    // threads only wait for a core when there are more threads than cores
+    auto const preemptions = static_cast<preemption_count const &>(*counted.front()).preemptions;
+    if(m->arch.size() < f.app->threads().size()) {
+      expect(preemptions > 0, v.name + ": no thread was preempted");
+    } else {
+      expect(preemptions == 0, v.name + ": a thread was preempted without another waiting");
+    }
+  }
+}
+
+void waits_keep_their_time(fixture const &f)
+{
+  simsync::architecture arch(f.data + "/cores2.json");
+  auto &c = arch.get_core(0);
+  c.scale_frequency(0);
+
+  simsync::thread_tracker threads(f.app->threads());
+  threads.seek(1, 1);
+  threads.start(1, c);
+  auto const computation = threads.time_remaining(1);
+
+  // a context switch or lock wait lasts as long at any frequency, but the computation and a warm-up speed up
+  auto const wait = simsync::picoseconds(1000000);
+  auto const warm_up = simsync::picoseconds(3000000);
+  threads.delay(1, wait);
+  threads.extend(1, warm_up);
+  c.scale_frequency(1);
+  threads.retime(1, c);
+
+  auto const expected = wait + (warm_up + computation + simsync::picoseconds(2)) / 3;
+  auto const rescaled = threads.time_remaining(1);
+  expect(rescaled == expected, "the wait was rescaled with the computation: " + std::to_string(rescaled.count())
+                                   + "ps, expected " + std::to_string(expected.count()) + "ps");
+
+  // the wait is over before any of the work is done
+  threads.elapse(wait);
+  c.scale_frequency(0);
+  threads.retime(1, c);
+  auto const remaining = threads.time_remaining(1);
+  expect(remaining >= warm_up + computation && remaining <= warm_up + computation + simsync::picoseconds(2),
+      "the computation did not return to its speed once the wait was over");
+}
+
+void sensitivity_matches_finite_difference(fixture const &f)
+{
+  // the sensitivity is only exact where cores keep their speed, and the step is small enough not to reorder events
+  auto const step = 0.001;
+
+  for(auto const &name : {"static", "oversubscribed"}) {
+    auto const &v = find_variant(f, name);
+    auto m = f.load(v);
+
+    reports measured;
+    measured.emplace_back(std::make_unique<simsync::cpi_sensitivity>("/dev/null", *f.app, m->sys));
+    auto const time = simsync::estimate(*f.app, m->sys, measured);
+    auto const &sensitivity = static_cast<simsync::cpi_sensitivity const &>(*measured.front());
+
+    for(auto const &t : sensitivity.critical_time()) {
+      // the CPI is scaled before the system takes the architecture's cores
+      simsync::architecture arch(f.data + "/" + v.config);
+      arch.scale_cpi_rate(t.first, 1.0 + step);
+      simsync::system sys(f.data + "/" + v.config, arch);
+      v.configure(sys);
+      auto const difference = (simsync::estimate(*f.app, sys, reports{}) - time).count() / step;
+
+      auto const predicted = std::chrono::duration<double, std::nano>(t.second).count();
+      expect(std::abs(difference - predicted) <= 0.01 * predicted,
+          v.name + ": thread " + std::to_string(t.first) + " has a sensitivity of " + std::to_string(predicted)
+              + "ns, but a finite difference of " + std::to_string(difference) + "ns");
+    }
+  }
+}
+
+void energy_matches_power(fixture const &f)
+{
+  // every thread computes at the static 1 GHz level, which draws 2 W, and idle cores draw 0.5 W
+  machine m(f.data + "/power6.json");
+  auto const output = "energy_use.csv";
+  std::chrono::nanoseconds time(0);
+  {
+    reports energy;
+    energy.emplace_back(std::make_unique<simsync::energy_use>(output, m.sys));
+    time = simsync::estimate(*f.app, m.sys, energy);
+  }
+
+  std::map<std::string, double> totals;
+  std::map<int32_t, double> threads;
+  std::ifstream table(output);
+  std::string line;
+  std::getline(table, line);
+  while(std::getline(table, line)) {
+    auto const first = line.find(',');
+    auto const second = line.find(',', first + 1);
+    auto const component = line.substr(0, first);
+    auto const value = std::stod(line.substr(second + 1));
+    if(component == "thread") {
+      threads[std::stoi(line.substr(first + 1, second - first - 1))] = value;
+    } else {
+      totals[component] += value;
+    }
+  }
+  std::remove(output);
+
+  // the report has six significant digits
+  auto const close = [](double const actual, double const expected) {
+    return std::abs(actual - expected) <= 1e-5 * expected;
+  };
+
+  // a thread is charged for the time it computes on its core
+  double busy = 0.0;
+  auto const &type = m.arch.get_core(0).type();
+  for(auto const &t : f.app->threads()) {
+    simsync::picoseconds computing(0);
+    for(size_t index = 0; index < t.second.size(); ++index) {
+      computing += simsync::estimate_time(t.second.get_computation(index), 0, type.get_cpi(t.first), 1000000000);
+    }
+
+    auto const seconds = std::chrono::duration<double>(computing).count();
+    expect(close(threads[t.first], 2.0 * seconds),
+        "thread " + std::to_string(t.first) + " used " + std::to_string(threads[t.first]) + "J, expected "
+            + std::to_string(2.0 * seconds) + "J");
+    busy += seconds;
+  }
+
+  auto const seconds = std::chrono::duration<double>(time).count();
+  auto const energy = 2.0 * busy + 0.5 * (6.0 * seconds - busy);
+  expect(close(totals["core"], totals["energy"]), "the cores do not add up to the total energy");
+  expect(close(totals["energy"], energy),
+      "used " + std::to_string(totals["energy"]) + "J, expected " + std::to_string(energy) + "J");
+  expect(close(totals["time"], seconds), "the energy was reported at the wrong time");
+  expect(close(totals["edp"], energy * seconds), "the energy-delay product is not the energy times the delay");
+}
+
+void levels_draw_their_power(fixture const &f)
+{
+  // the contention governor drops to the first of two levels at the static frequency, which draws more power
+  machine fixed(f.data + "/power6.json");
+  auto const time = simsync::estimate(*f.app, fixed.sys, reports{});
+
+  machine governed(f.data + "/power6.json");
+  governed.sys.set_governor(simsync::make_frequency_governor("contention", {}));
+  expect_equal(simsync::estimate(*f.app, governed.sys, reports{}), time, "contention");
+  expect(total_energy(governed.sys, time) > total_energy(fixed.sys, time),
+      "a level change at the same frequency did not change the power");
+}
+
+void siblings_run_slower(fixture const &f)
+{
+  // the same cores, but pairs of them share a physical core
+  auto const separate = sequential(f, find_variant(f, "static"));
+  auto const shared = sequential(f, find_variant(f, "siblings"));
+  expect(shared > separate, "threads on busy siblings ran as fast as on separate cores");
+}
+
+void siblings_share_power(fixture const &f)
+{
+  // every level and idle draw the same power, so each physical core draws it all the time, whether its siblings are
+  // busy or not
+  machine m(f.data + "/siblings-power6.json");
+  auto const time = simsync::estimate(*f.app, m.sys, reports{});
+
+  auto const physical_cores = 3.0;
+  auto const expected = physical_cores * 2.0 * std::chrono::duration<double>(time).count();
+  auto const energy = total_energy(m.sys, time);
+  expect(std::abs(energy - expected) <= 1e-9 * expected,
+      "siblings used " + std::to_string(energy) + "J, expected " + std::to_string(expected) + "J");
+}
+
+void sweep_matches_sequential(fixture const &f)
+{
+  std::vector<std::string> const configs{f.data + "/cores6.json", f.data + "/cores2.json"};
+
+  simsync::sweep_options options;
+  options.workers = 2;
+  auto const results = simsync::sweep(*f.app, configs, options);
+  expect(results.size() == configs.size(), "the sweep did not estimate every config");
+
+  auto const &many = find_variant(f, "static");
+  auto const &few = find_variant(f, "oversubscribed");
+  expect(results[0].config == configs[0] && results[1].config == configs[1], "the sweep reordered the configs");
+  expect(results[0].cores == 6 && results[1].cores == 2, "the sweep counted the wrong number of cores");
+  expect(results[0].complete && results[1].complete, "the sweep gave up without a deadline");
+  expect_equal(results[0].execution_time, sequential(f, many), many.name);
+  expect_equal(results[1].execution_time, sequential(f, few), few.name);
+
+  // the overrides apply to every config, as they do to a single one
+  options.migration_penalty = 20000;
+  auto const migrating = simsync::sweep(*f.app, configs, options);
+  for(size_t index = 0; index < configs.size(); ++index) {
+    machine m(configs[index]);
+    m.sys.set_migration_penalty(options.migration_penalty);
+    expect_equal(migrating[index].execution_time, simsync::estimate(*f.app, m.sys, reports{}), configs[index]);
+  }
+  expect(migrating[0].execution_time > results[0].execution_time, "the sweep ignored the migration penalty");
+
+  // pruned configs are given up on, but the fastest one always completes
+  options = simsync::sweep_options{};
+  options.workers = 1;
+  options.prune = true;
+  auto const pruned = simsync::sweep(*f.app, configs, options);
+  expect(pruned[0].complete, "the fastest config was pruned");
+  expect(!pruned[1].complete, "a config slower than one already finished was not pruned");
+  expect(pruned[1].execution_time > pruned[0].execution_time, "a pruned config was faster than the fastest");
+}
+
+void replicates_match_sampled_runs(fixture const &f)
+{
+  auto const &v = find_variant(f, "static");
+  auto m = f.load(v);
+
+  simsync::monte_carlo_options options;
+  options.replicates = 8;
+  options.seed = 3;
+  options.workers = 2;
+  auto const result = simsync::estimate_replicates(*f.app, m->sys, options);
+  expect(result.execution_times.size() == options.replicates, "not every replicate was simulated");
+
+  // each replicate is a simulation sampling CPIs with its own seed
+  double sum = 0.0;
+  for(size_t replicate = 0; replicate < options.replicates; ++replicate) {
+    auto sampled = f.load(v);
+    reports none;
+    simsync::simulation sim(*f.app, sampled->sys, none);
+    sim.sample_cpi(options.seed + replicate);
+    expect_equal(result.execution_times[replicate], sim.run(), "replicate " + std::to_string(replicate));
+
+    sum += static_cast<double>(result.execution_times[replicate].count());
+  }
+
+  auto const times = result.execution_times;
+  auto const fastest = *std::min_element(times.begin(), times.end());
+  auto const slowest = *std::max_element(times.begin(), times.end());
+  expect(fastest < slowest, "the sampled CPIs did not change the execution time");
+  expect(std::abs(static_cast<double>(result.mean.count()) - sum / options.replicates) <= 0.5,
+      "the mean is not the mean of the replicates");
+  expect(result.standard_deviation.count() > 0, "the replicates have no deviation");
+  expect(result.confidence_lower < result.mean && result.mean < result.confidence_upper,
+      "the confidence interval does not contain the mean");
+  expect(result.confidence_upper - result.confidence_lower < slowest - fastest,
+      "the confidence interval of the mean is wider than the replicates");
+
+  expect_equal(simsync::percentile(result, 0.0), fastest, "the 0th percentile");
+  expect_equal(simsync::percentile(result, 1.0), slowest, "the 100th percentile");
+}
+
+void elided_locks_match_simulations(fixture const &f)
+{
+  // the trace's workers share two locks
+  auto const &v = find_variant(f, "oversubscribed");
+  auto m = f.load(v);
+
+  size_t acquisitions = 0;
+  for(auto const &t : f.app->threads()) {
+    for(size_t index = 0; index < t.second.size(); ++index) {
+      acquisitions += t.second.get_event(index)->get_type() == simsync::event_type::lock_acquire ? 1 : 0;
+    }
+  }
+
+  simsync::lock_elision_options options;
+  options.workers = 2;
+  std::chrono::nanoseconds baseline(0);
+  auto const results = simsync::estimate_lock_elision(*f.app, m->sys, options, &baseline);
+  expect(results.size() == 2, std::to_string(results.size()) + " locks were elided, expected 2");
+  expect_equal(baseline, sequential(f, v), "the baseline");
+
+  for(size_t index = 0; index < results.size(); ++index) {
+    auto const &r = results[index];
+    acquisitions -= r.acquisitions;
+
+    auto elided = f.load(v);
+    reports none;
+    simsync::simulation sim(*f.app, elided->sys, none);
+    sim.elide_lock(r.lock);
+    expect_equal(r.execution_time, sim.run(), "lock " + std::to_string(r.lock));
+    expect(r.speedup == static_cast<double>(baseline.count()) / static_cast<double>(r.execution_time.count()),
+        "the speedup of lock " + std::to_string(r.lock) + " is not the baseline over its execution time");
+    expect(index == 0 || results[index - 1].speedup >= r.speedup, "the locks are not ordered by speedup");
+  }
+  expect(acquisitions == 0, "the acquisitions of the locks do not add up to those in the trace");
+
+  // only the most acquired lock is elided
+  options.top = 1;
+  auto const top = simsync::estimate_lock_elision(*f.app, m->sys, options);
+  auto const most = std::max_element(results.begin(), results.end(),
+      [](auto const &a, auto const &b) { return a.acquisitions < b.acquisitions; });
+  expect(top.size() == 1 && top.front().lock == most->lock, "the top lock is not the most acquired one");
+}
+
+void co_schedule_matches_simulations(fixture const &f)
+{
+  // two copies of the trace share the cores
+  std::ifstream first(f.data + "/phases4.trace");
+  std::ifstream second(f.data + "/phases4.trace");
+  std::vector<std::istream *> streams{&first, &second};
+  simsync::application apps(streams);
+
+  auto const &v = find_variant(f, "static");
+  auto m = f.load(v);
+  auto const results = simsync::co_schedule(apps, m->sys, 2);
+  expect(results.size() == 2, std::to_string(results.size()) + " applications were scheduled, expected 2");
+
+  auto together = f.load(v);
+  auto const last = simsync::estimate(apps, together->sys, reports{});
+
+  auto const alone = sequential(f, v);
+  for(auto const &r : results) {
+    expect_equal(r.alone, alone, "alone");
+    expect(r.together > r.alone, "ten threads on six cores ran as fast as five");
+    expect(r.together <= last, "an application finished after the last event");
+    expect(r.slowdown == static_cast<double>(r.together.count()) / static_cast<double>(r.alone.count()),
+        "the slowdown is not the time together over the time alone");
+  }
+  expect(std::max(results[0].together, results[1].together) == last,
+      "neither application finished with the last event");
+}
+
+void siblings_are_listed_once(fixture const &f)
+{
+  for(auto const &config : {"siblings-repeated.json", "siblings-relisted.json"}) {
+    bool rejected = false;
+    try {
+      simsync::architecture arch(f.data + "/" + config);
+    } catch(std::runtime_error const &) {
+      rejected = true;
+    }
+
+    expect(rejected, std::string("the sibling groups of ") + config + " were accepted");
+  }
+}
+
+void cpi_rates_are_positive(fixture const &f)
+{
+  bool rejected = false;
+  try {
+    simsync::architecture arch(f.data + "/cpi-zero.json");
+  } catch(std::runtime_error const &) {
+    rejected = true;
+  }
+  expect(rejected, "a CPI rate of zero was accepted");
+
+  for(auto const factor : {0.0, -1.0, 1e-9}) {
+    simsync::architecture arch(f.data + "/cores2.json");
+    rejected = false;
+    try {
+      arch.scale_cpi_rate(1, factor);
+    } catch(std::runtime_error const &) {
+      rejected = true;
+    }
+    expect(rejected, "a CPI rate was scaled by " + std::to_string(factor));
+  }
+}
+}
+
+/**
+ * Compares the estimation modes with the sequential simulation on a small trace.
+ *
+ * Usage: simsync-test <data directory>
+ */
+int main(int argc, char **argv)
+{
+  if(argc != 2) {
+    std::cerr << "Missing Argument: Please provide the test data directory.\n";
+    return 1;
+  }
+
+  fixture f;
+  f.data = argv[1];
+  {
+    std::ifstream trace(f.data + "/phases4.trace");
+    std::vector<std::istream *> streams{&trace};
+    f.app = std::make_unique<simsync::application>(streams);
+  }
+  f.variants = make_variants();
+
+  std::vector<std::pair<std::string, std::function<void(fixture const &)>>> const tests{
+      {"hybrid matches sequential", hybrid_matches_sequential},
+      {"phases match sequential", phases_match_sequential},
+      {"sampled matches sequential", sampled_matches_sequential},
+      {"resume matches sequential", resume_matches_sequential},
+      {"resume keeps energy", resume_keeps_energy},
+      {"replay matches sequential", replay_matches_sequential},
+      {"replay rejects migration penalties", replay_rejects_migration_penalties},
+      {"bounds contain sequential", bounds_contain_sequential},
+      {"deadline does not skip", deadline_does_not_skip},
+      {"migrations are counted", migrations_are_counted},
+      {"fastest core is chosen", fastest_core_is_chosen},
+      {"preemption switches threads", preemption_switches_threads},
+      {"waits keep their time", waits_keep_their_time},
+      {"energy matches power", energy_matches_power},
+      {"levels draw their power", levels_draw_their_power},
+      {"siblings run slower", siblings_run_slower},
+      {"siblings share power", siblings_share_power},
+      {"sweep matches sequential", sweep_matches_sequential},
+      {"sensitivity matches finite difference", sensitivity_matches_finite_difference},
+      {"replicates match sampled runs", replicates_match_sampled_runs},
+      {"elided locks match simulations", elided_locks_match_simulations},
+      {"co-schedule matches simulations", co_schedule_matches_simulations},
+      {"siblings are listed once", siblings_are_listed_once},
+      {"CPI rates are positive", cpi_rates_are_positive},
+  };
+
+  size_t failures = 0;
+  for(auto const &test : tests) {
+    try {
+      test.second(f);
+      std::cout << "Pass: " << test.first << "\n";
+    } catch(std::exception const &e) {
+      std::cout << "Fail: " << test.first << ": " << e.what() << "\n";
+      ++failures;
+    }
+  }
+
+  return failures == 0 ? 0 : 1;
+}
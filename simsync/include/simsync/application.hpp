@@ -4,9 +4,11 @@
 #include <simsync/thread.hpp>
 #include <simsync/synchronization/thread_model.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <iosfwd>
 #include <map>
+#include <vector>
 
 namespace simsync {
 
@@ -14,6 +16,8 @@ namespace simsync {
  * An application model.
  *
  * Represents an application as a collection of simsync::thread, which synchronize through a simsync::thread_model.
+ * Several applications can share one model to be scheduled together, each with its own namespace of thread IDs (see
+ * simsync::application_thread_stride) and synchronization objects.
  */
 class application {
 public:
@@ -24,6 +28,26 @@ public:
    */
   explicit application(std::istream &trace);
 
+  /**
+   * Construct several applications that are scheduled together from their traces.
+   *
+   * @param traces The trace input of each application, which are expected to be valid.
+   */
+  explicit application(std::vector<std::istream *> const &traces);
+
+  /**
+   * @return The number of applications scheduled together, which is one for an application built from one trace.
+   */
+  size_t applications() const
+  {
+    return m_applications;
+  }
+
+  /**
+   * @return The master thread (assumed to have local ID 0) of each application, mapped to its first computation.
+   */
+  std::map<int32_t, size_t> masters() const;
+
   /**
    * Get one of the threads of the application.
    *
@@ -38,10 +62,19 @@ public:
    */
   std::map<int32_t, thread> const &threads() const;
 
+  /**
+   * @return The synchronization state before any thread has started. Each simulation works on its own copy.
+   */
+  thread_model const &get_thread_model() const;
+
 private:
+  size_t m_applications = 0;
+
   thread_model m_thread_model;
 
   std::map<int32_t, thread> m_threads;
+
+  void parse(std::istream &trace);
 };
 }
 
@@ -5,14 +5,29 @@
 #include <simsync/core_type.hpp>
 
 #include <cstdint>
+#include <cstddef>
 #include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace simsync {
 
 /**
  * An architecture model.
  *
- * Represents an application as a collection of simsync::core.
+ * Represents an application as a collection of simsync::core. Copies share the (immutable) core types, but each copy
+ * has its own cores, so that simulations running at the same time can scale frequencies independently.
+ *
+ * Logical cores that share a physical core, as with simultaneous multithreading, are listed as groups of core indices
+ * in the optional "siblings" entry of the "architecture" configuration. A thread on a core whose siblings are busy runs
+ * with its CPI multiplied by the "sibling.cpi.factor" entry, which is required with sibling groups, for each busy
+ * sibling (see simsync::core::set_busy_siblings).
+ *
+ * Each frequency level of a core type may have an active "power" entry and each core type an "idle.power" entry, both
+ * in watts, which simsync::system integrates into the energy used by each core and thread. The power of a core type
+ * is that of a physical core, which sibling cores share.
  */
 class architecture {
 public:
@@ -37,11 +52,93 @@ public:
    */
   core &get_core(size_t index);
 
+  /**
+   * Get the core residing at the index.
+   *
+   * @param index The desired core.
+   *
+   * @return The core model.
+   */
+  core const &get_core(size_t index) const;
+
+  /**
+   * @param index A core.
+   *
+   * @return The other cores in the core's sibling group, which is empty if it has none.
+   */
+  std::vector<size_t> const &siblings(size_t index) const
+  {
+    return m_siblings[index];
+  }
+
+  /**
+   * @return For each core, the other cores in its sibling group.
+   */
+  std::deque<std::vector<size_t>> const &siblings() const
+  {
+    return m_siblings;
+  }
+
+  /**
+   * @return The factor a thread's CPI is multiplied by for each busy sibling of its core.
+   */
+  double sibling_factor() const
+  {
+    return m_sibling_factor;
+  }
+
+  /**
+   * @return true if any cores share a physical core.
+   */
+  bool has_siblings() const
+  {
+    return m_has_siblings;
+  }
+
+  /**
+   * @return true if any core type has an active or idle power.
+   */
+  bool has_power() const
+  {
+    return m_has_power;
+  }
+
+  /**
+   * @return true if all cores are of the same type.
+   */
+  bool is_homogeneous() const;
+
+  /**
+   * Scale the cycles-per-instruction of a thread on every core type.
+   *
+   * The core types are shared with other copies of this architecture, so this architecture gets its own. All cores
+   * return to their initial frequency, so this should be done before simulating.
+   *
+   * @param thread_id The ID of the thread.
+   * @param factor The factor to multiply the CPI by, which must be positive.
+   */
+  void scale_cpi_rate(int32_t thread_id, double factor);
+
 private:
   // each key corresponds to a core id
   std::deque<core> m_cores;
 
-  std::map<int32_t, core_type> m_types;
+  std::shared_ptr<std::map<int32_t, core_type> const> m_types;
+
+  // the type of each core
+  std::deque<int32_t> m_core_types;
+
+  // the other cores in each core's sibling group
+  std::deque<std::vector<size_t>> m_siblings;
+
+  bool m_has_siblings = false;
+
+  bool m_has_power = false;
+
+  // the CPI factor per busy sibling
+  double m_sibling_factor = 1.0;
+
+  void create_cores();
 };
 }
 
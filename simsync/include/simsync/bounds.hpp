@@ -0,0 +1,51 @@
+#ifndef SIMSYNC_BOUNDS_HPP
+#define SIMSYNC_BOUNDS_HPP
+
+#include <chrono>
+
+namespace simsync {
+class application;
+class system;
+
+/**
+ * Bounds on the execution time of an application, found without simulating it.
+ */
+struct bounds {
+  std::chrono::nanoseconds lower;
+  std::chrono::nanoseconds upper;
+};
+
+/**
+ * Bound how long an simsync::application would take to run on a simsync::system.
+ *
+ * No thread can finish sooner than it would on the fastest core for it, and the cores cannot finish all threads
+ * sooner than if they shared the work perfectly. At least one thread computes whenever time passes, so the execution
+ * time is at most the time to run every thread, one after another, on the slowest core for it with every sibling of
+ * that core busy. Threads run at their static frequency levels, unless the system's governor is dynamic, in which case
+ * they may run at any level. Time passes without any thread computing while threads pay context switch or migration
+ * costs, so the execution time has no upper bound if either is charged.
+ *
+ * @param app The application to bound.
+ * @param sys The system the application would run on.
+ *
+ * @return The lower and upper bounds, where an upper bound of nanoseconds::max() means there is none.
+ */
+bounds estimate_bounds(application const &app, system const &sys);
+
+/**
+ * Estimate how long an simsync::application would take to run on a simsync::system, without simulating it.
+ *
+ * Each thread is assumed to run at its average speed over all cores. The application is split into simsync::phases,
+ * and each phase takes as long as the slowest of: its longest thread, all of its threads sharing the cores perfectly,
+ * and the computations inside the critical sections of its most contended lock, which must run one at a time. The
+ * phases run one after another. This takes time proportional to the size of the trace.
+ *
+ * @param app The application to estimate.
+ * @param sys The system the application would run on, whose cores run each thread at its static frequency.
+ *
+ * @return an estimate of the application's execution time.
+ */
+std::chrono::nanoseconds estimate_analytic(application const &app, system const &sys);
+}
+
+#endif //SIMSYNC_BOUNDS_HPP
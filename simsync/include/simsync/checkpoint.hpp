@@ -0,0 +1,100 @@
+#ifndef SIMSYNC_CHECKPOINT_HPP
+#define SIMSYNC_CHECKPOINT_HPP
+
+#include <simsync/architecture.hpp>
+#include <simsync/cpi_sampler.hpp>
+#include <simsync/system.hpp>
+#include <simsync/thread_tracker.hpp>
+#include <simsync/timing.hpp>
+#include <simsync/reports/report.hpp>
+#include <simsync/synchronization/thread_model.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+
+namespace simsync {
+
+/**
+ * The complete state of a simulation at a point in time.
+ *
+ * A checkpoint holds the progress of every thread, the synchronization state, the assignment of threads to cores and
+ * the accumulated results of every report that can be split. Reports that cannot be split (e.g., traces) are not
+ * saved, so a simulation resumed from a checkpoint only records the events that follow it. A simulation that samples
+ * CPIs resumes sampling with the same seed. A checkpoint is only valid for the simsync::application it was taken from.
+ */
+class checkpoint {
+public:
+  checkpoint(checkpoint const &) = delete;
+
+  checkpoint &operator=(checkpoint const &) = delete;
+
+  /**
+   * @return The simulated time at which the checkpoint was taken.
+   */
+  std::chrono::nanoseconds time() const
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(m_time);
+  }
+
+  /**
+   * @return The number of events processed before the checkpoint was taken.
+   */
+  uint64_t events() const
+  {
+    return m_events;
+  }
+
+  /**
+   * @return The synchronization state at the checkpoint.
+   */
+  thread_model const &get_thread_model() const
+  {
+    return m_thread_model;
+  }
+
+private:
+  friend class simulation;
+
+  checkpoint(picoseconds time,
+      uint64_t events,
+      thread_model const &tm,
+      thread_tracker const &threads,
+      cpi_sampler const *sampler,
+      system const &sys,
+      std::deque<std::unique_ptr<report>> const &reports);
+
+  picoseconds m_time;
+
+  uint64_t m_events;
+
+  thread_model m_thread_model;
+
+  thread_tracker m_threads;
+
+  // a copy of the simulation's CPI sampler, or nullptr if it used mean CPIs
+  std::unique_ptr<cpi_sampler> m_sampler;
+
+  architecture m_architecture;
+
+  system m_system;
+
+  // a copy of each report, or nullptr if the report cannot be split
+  std::deque<std::unique_ptr<report>> m_reports;
+};
+
+/**
+ * When to take checkpoints during a simulation.
+ */
+struct checkpoint_options {
+  // take a checkpoint each time this much simulated time has passed, or zero for none
+  std::chrono::nanoseconds interval = std::chrono::nanoseconds(0);
+  // take a checkpoint each time this many events have been processed, or zero for none
+  uint64_t events = 0;
+  // receives the checkpoints in the order they were taken
+  std::deque<std::unique_ptr<checkpoint>> *checkpoints = nullptr;
+};
+}
+
+#endif //SIMSYNC_CHECKPOINT_HPP
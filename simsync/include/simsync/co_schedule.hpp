@@ -0,0 +1,39 @@
+#ifndef SIMSYNC_CO_SCHEDULE_HPP
+#define SIMSYNC_CO_SCHEDULE_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace simsync {
+class application;
+class system;
+
+/**
+ * How one of several applications scheduled together fares against running alone.
+ */
+struct co_schedule_result {
+  // the execution time of the application when it has the system to itself
+  std::chrono::nanoseconds alone;
+  // the time the application finishes when all applications start together
+  std::chrono::nanoseconds together;
+  // the time together divided by the time alone
+  double slowdown;
+};
+
+/**
+ * Estimate how several applications slow each other down by sharing the cores of one simsync::system.
+ *
+ * The applications are simulated together, starting at the same time, and each alone. The simulations run on a pool of
+ * worker threads, and share the applications and the core types; each has its own copy of the system.
+ *
+ * @param apps The applications scheduled together (see simsync::application::applications).
+ * @param sys The system to run the applications on, which is copied for each simulation and not run itself.
+ * @param workers The number of worker threads, or zero to use one per hardware thread.
+ *
+ * @return The result for each application, in order.
+ */
+std::vector<co_schedule_result> co_schedule(application const &apps, system const &sys, size_t workers);
+}
+
+#endif //SIMSYNC_CO_SCHEDULE_HPP
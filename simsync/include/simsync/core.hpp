@@ -1,6 +1,8 @@
 #ifndef SIMSYNC_CORE_HPP
 #define SIMSYNC_CORE_HPP
 
+#include <simsync/timing.hpp>
+
 #include <cstdint>
 #include <map>
 
@@ -38,17 +40,80 @@ public:
   }
 
   /**
-   * Get the cycles-per-instruction for a thread running on this core.
+   * @return The current frequency level.
+   */
+  int32_t level() const
+  {
+    return m_level;
+  }
+
+  /**
+   * @return The power this core draws while executing a thread at its current frequency level, in watts.
+   */
+  double active_power() const;
+
+  /**
+   * @return The type of this core.
+   */
+  core_type const &type() const
+  {
+    return m_type;
+  }
+
+  /**
+   * Set how much slower a thread runs on this core for each busy sibling, i.e., each other logical core that shares
+   * its physical core.
+   *
+   * @param factor The factor to multiply the CPI by when one sibling is busy.
+   */
+  void set_sibling_factor(double factor);
+
+  /**
+   * @return The number of siblings of this core that are executing a thread.
+   */
+  size_t busy_siblings() const
+  {
+    return m_busy_siblings;
+  }
+
+  /**
+   * Set the number of siblings of this core that are executing a thread. With n busy siblings and a sibling factor of
+   * f, threads run with their CPI multiplied by 1 + n * (f - 1).
+   *
+   * @param count The number of busy siblings.
+   */
+  void set_busy_siblings(size_t count);
+
+  /**
+   * Get the cycles-per-instruction for a thread running on this core, given how many of its siblings are busy.
    *
    * @param thread_id The ID of the thread.
-   * @return The CPI.
+   * @return The CPI in fixed point.
    */
-  double get_cpi(int32_t thread_id) const;
+  fixed_cpi get_cpi(int32_t thread_id) const;
+
+  /**
+   * Get the standard deviation of the cycles-per-instruction for a thread running on this core.
+   *
+   * The standard deviation is scaled with the CPI.
+   *
+   * @param thread_id The ID of the thread.
+   * @return The standard deviation in fixed point, which is zero if the CPI does not vary.
+   */
+  fixed_cpi get_cpi_stddev(int32_t thread_id) const;
 
 private:
   core_type const &m_type;
 
   int64_t m_frequency;
+  int32_t m_level = 0;
+
+  double m_sibling_factor = 1.0;
+  size_t m_busy_siblings = 0;
+  // the factor CPIs are multiplied by, if any siblings are busy
+  double m_cpi_scale = 1.0;
+
+  fixed_cpi scale_cpi(fixed_cpi cpi) const;
 };
 }
 
@@ -1,6 +1,8 @@
 #ifndef SIMSYNC_CORE_TYPE_HPP
 #define SIMSYNC_CORE_TYPE_HPP
 
+#include <simsync/timing.hpp>
+
 #include <cstdint>
 #include <deque>
 #include <map>
@@ -16,10 +18,26 @@ public:
    * Assign the cycles-per-instruction for a particular thread that may run on this core.
    *
    * @param thread_id The ID of the thread.
-   * @param cpi_rate The CPI rate for the thread running on this core.
+   * @param cpi_rate The CPI rate for the thread running on this core, which must be positive.
    */
   void add_cpi_rate(int32_t thread_id, double cpi_rate);
 
+  /**
+   * Assign the standard deviation of the cycles-per-instruction for a thread, whose CPI varies between computations.
+   *
+   * @param thread_id The ID of the thread.
+   * @param cpi_stddev The standard deviation of the CPI rate for the thread running on this core.
+   */
+  void add_cpi_stddev(int32_t thread_id, double cpi_stddev);
+
+  /**
+   * Scale the cycles-per-instruction of a thread, if it may run on this core.
+   *
+   * @param thread_id The ID of the thread.
+   * @param factor The factor to multiply the CPI by, which must be positive.
+   */
+  void scale_cpi_rate(int32_t thread_id, double factor);
+
   /**
    * Add a possible frequency for this core type.
    *
@@ -28,13 +46,39 @@ public:
    */
   void add_frequency(int32_t level, int64_t frequency);
 
+  /**
+   * Set the power a core of this type draws while executing a thread at a frequency level.
+   *
+   * @param level The ID for the frequency level.
+   * @param watts The active power in watts.
+   */
+  void add_power(int32_t level, double watts);
+
+  /**
+   * Set the power a core of this type draws while no thread executes on it.
+   *
+   * @param watts The idle power in watts.
+   */
+  void set_idle_power(double watts);
+
   /**
    * Get the cycles-per-instruction for a thread running on this core.
    *
+   * A thread of an application scheduled alongside others that has no CPI of its own uses the CPI of the thread with
+   * the same local ID in the first application.
+   *
+   * @param thread_id The ID of the thread.
+   * @return The CPI in fixed point.
+   */
+  fixed_cpi get_cpi(int32_t thread_id) const;
+
+  /**
+   * Get the standard deviation of the cycles-per-instruction for a thread running on this core.
+   *
    * @param thread_id The ID of the thread.
-   * @return The CPI.
+   * @return The standard deviation in fixed point, which is zero if the CPI does not vary.
    */
-  double get_cpi(int32_t thread_id) const;
+  fixed_cpi get_cpi_stddev(int32_t thread_id) const;
 
   /**
    * Get the frequency for the specified level.
@@ -44,11 +88,52 @@ public:
    */
   int64_t get_frequency(int32_t id) const;
 
+  /**
+   * @return The frequency level with the highest frequency.
+   */
+  int32_t fastest_level() const;
+
+  /**
+   * @return The frequency level with the lowest frequency.
+   */
+  int32_t slowest_level() const;
+
+  /**
+   * Get the next frequency level down from another.
+   *
+   * @param id The frequency level.
+   * @return The level with the highest frequency below that of id, or id if there is none.
+   */
+  int32_t slower_level(int32_t id) const;
+
+  /**
+   * Get the power a core of this type draws while executing a thread.
+   *
+   * @param id The frequency level.
+   * @return The active power in watts, or zero if none was configured.
+   */
+  double get_power(int32_t id) const;
+
+  /**
+   * @return The power a core of this type draws while idle in watts, or zero if none was configured.
+   */
+  double idle_power() const
+  {
+    return m_idle_power;
+  }
+
 private:
   std::map<int32_t, int64_t> m_frequencies;
 
+  // the active power at each frequency level, in watts
+  std::map<int32_t, double> m_power;
+  double m_idle_power = 0.0;
+
   // each key corresponds to a thread id
-  std::map<int32_t, double> m_cpi_rates;
+  std::map<int32_t, fixed_cpi> m_cpi_rates;
+
+  // each key corresponds to a thread id, for threads whose CPI varies
+  std::map<int32_t, fixed_cpi> m_cpi_stddevs;
 };
 }
 
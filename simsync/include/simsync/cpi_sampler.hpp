@@ -0,0 +1,45 @@
+#ifndef SIMSYNC_CPI_SAMPLER_HPP
+#define SIMSYNC_CPI_SAMPLER_HPP
+
+#include <simsync/timing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace simsync {
+
+/**
+ * Samples the cycles-per-instruction of each computation from a normal distribution.
+ *
+ * Each sample depends only on the seed, the thread and the index of the computation, so a computation has the same CPI
+ * however many times it is timed, and the samples do not depend on the order events are simulated in.
+ */
+class cpi_sampler {
+public:
+  /**
+   * Construct a sampler.
+   *
+   * @param seed The seed that, with the thread and computation, determines each sample.
+   */
+  explicit cpi_sampler(uint64_t seed) : m_seed(seed)
+  {
+  }
+
+  /**
+   * Sample the cycles-per-instruction of a computation.
+   *
+   * @param mean The mean CPI of the thread on its core.
+   * @param stddev The standard deviation of the CPI of the thread on its core.
+   * @param thread_id The ID of the thread.
+   * @param index The index of the computation.
+   *
+   * @return The CPI, which is at least one millionth of a cycle.
+   */
+  fixed_cpi sample(fixed_cpi mean, fixed_cpi stddev, int32_t thread_id, size_t index) const;
+
+private:
+  uint64_t m_seed;
+};
+}
+
+#endif //SIMSYNC_CPI_SAMPLER_HPP
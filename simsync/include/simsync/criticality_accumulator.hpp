@@ -0,0 +1,76 @@
+#ifndef SIMSYNC_CRITICALITY_ACCUMULATOR_HPP
+#define SIMSYNC_CRITICALITY_ACCUMULATOR_HPP
+
+#include <simsync/timing.hpp>
+
+#include <cstdint>
+#include <map>
+
+namespace simsync {
+class system;
+
+/**
+ * Measures how critical each thread is to the execution time.
+ *
+ * While other threads wait, each executing thread accumulates the time passed divided by the number of waiting
+ * threads. Time in which only one thread executes is not counted.
+ */
+class criticality_accumulator {
+public:
+  criticality_accumulator() = default;
+
+  /**
+   * @param start_time The time to start accumulating from.
+   */
+  explicit criticality_accumulator(picoseconds start_time) : m_last_time(start_time)
+  {
+  }
+
+  /**
+   * Account for the time since the last update.
+   *
+   * @param current_time The present time.
+   * @param sys The operating system, as it was since the last update.
+   */
+  void update(picoseconds current_time, system const &sys);
+
+  /**
+   * Add the criticality accumulated by another accumulator that started at an offset.
+   *
+   * @param other The other accumulator.
+   * @param offset The time the other accumulator started at.
+   */
+  void merge(criticality_accumulator const &other, picoseconds offset);
+
+  /**
+   * @return For each thread that has accumulated any criticality: its criticality, in picoseconds.
+   */
+  std::map<int32_t, int64_t> const &threads() const
+  {
+    return m_criticality;
+  }
+
+  /**
+   * @param thread_id The thread.
+   * @return The criticality of the thread, in picoseconds.
+   */
+  int64_t criticality(int32_t thread_id) const;
+
+  /**
+   * @return The criticality of all threads together, in picoseconds.
+   */
+  int64_t total() const
+  {
+    return m_total;
+  }
+
+private:
+  picoseconds m_last_time = picoseconds(0);
+
+  // in picoseconds
+  std::map<int32_t, int64_t> m_criticality;
+  int64_t m_total = 0;
+};
+}
+
+#endif //SIMSYNC_CRITICALITY_ACCUMULATOR_HPP
@@ -1,7 +1,10 @@
 #ifndef SIMSYNC_SIMULATE_HPP
 #define SIMSYNC_SIMULATE_HPP
 
+#include <simsync/reports/report_set.hpp>
+
 #include <chrono>
+#include <cstddef>
 #include <deque>
 #include <memory>
 
@@ -10,12 +13,18 @@
  */
 namespace simsync {
 class application;
+class checkpoint;
 class system;
 class report;
+struct checkpoint_options;
+struct hot_lock_options;
 
 /**
  * Simulate how an simsync::application would run on a simsync::system.
  *
+ * This runs a simsync::simulation to completion. Use a simsync::simulation directly to run part of an application,
+ * report progress or cancel.
+ *
  * @param app The application to run.
  * @param sys The system to run the application on.
  * @param out The reports to generate during this simulation.
@@ -24,6 +33,166 @@ class report;
  */
 std::chrono::nanoseconds
 estimate(application const &app, system &sys, std::deque<std::unique_ptr<report>> const &reports);
+
+/**
+ * Simulate how an simsync::application would run on a simsync::system, with reports known at compile time.
+ *
+ * This has no report code when the set is empty, and updates each report with a direct call otherwise. It is only
+ * compiled for the report sets listed by SIMSYNC_FOR_EACH_REPORT_SET.
+ *
+ * @param app The application to run.
+ * @param sys The system to run the application on.
+ * @param out The reports to generate during this simulation.
+ *
+ * @return an estimate of the application's execution time.
+ */
+template <typename... Reports>
+std::chrono::nanoseconds estimate(application const &app, system &sys, report_set<Reports...> &reports);
+
+/**
+ * Simulate how an simsync::application would run on a simsync::system, taking checkpoints along the way.
+ *
+ * @param app The application to run.
+ * @param sys The system to run the application on.
+ * @param out The reports to generate during this simulation.
+ * @param options When to take checkpoints, and where to put them.
+ *
+ * @return an estimate of the application's execution time.
+ */
+std::chrono::nanoseconds estimate(application const &app,
+    system &sys,
+    std::deque<std::unique_ptr<report>> const &reports,
+    checkpoint_options const &options);
+
+/**
+ * Simulate how an simsync::application would run on a simsync::system, giving up once it takes too long.
+ *
+ * The simulation is skipped if simsync::estimate_bounds shows the application cannot finish by the deadline, and is
+ * stopped as soon as the next event would happen after the deadline. The reports then only cover the part of the
+ * application that was simulated.
+ *
+ * @param app The application to run.
+ * @param sys The system to run the application on.
+ * @param out The reports to generate during this simulation.
+ * @param deadline The longest execution time of interest.
+ *
+ * @return an estimate of the application's execution time if it is within the deadline, otherwise a time after the
+ * deadline that the execution time is known to exceed.
+ */
+std::chrono::nanoseconds estimate(application const &app,
+    system &sys,
+    std::deque<std::unique_ptr<report>> const &reports,
+    std::chrono::nanoseconds deadline);
+
+/**
+ * Simulate how an simsync::application would run on a simsync::system, approximating the waits for frequently acquired
+ * locks with a queueing model instead of simulating each acquisition (see simsync::hot_lock_model).
+ *
+ * @param app The application to run.
+ * @param sys The system to run the application on.
+ * @param out The reports to generate during this simulation.
+ * @param options When to approximate locks, and where to put a summary of what was approximated.
+ *
+ * @return an estimate of the application's execution time.
+ */
+std::chrono::nanoseconds estimate(application const &app,
+    system &sys,
+    std::deque<std::unique_ptr<report>> const &reports,
+    hot_lock_options const &options);
+
+/**
+ * Continue a simulation from a simsync::checkpoint, possibly on a differently configured system.
+ *
+ * See the simsync::simulation constructor taking a simsync::checkpoint.
+ *
+ * @param app The application the checkpoint was taken from.
+ * @param from The checkpoint to continue from.
+ * @param sys The system to continue on, which must have as many cores as the checkpoint's and not have run before.
+ * @param out The reports to generate during this simulation, which should not have been updated before.
+ * @param options When to take further checkpoints, and where to put them.
+ *
+ * @return an estimate of the application's execution time, including the time before the checkpoint.
+ */
+std::chrono::nanoseconds resume(application const &app,
+    checkpoint const &from,
+    system &sys,
+    std::deque<std::unique_ptr<report>> const &reports,
+    checkpoint_options const &options);
+
+/**
+ * Options for simsync::estimate_phases.
+ */
+struct phase_options {
+  // the number of worker threads, or zero to use one per hardware thread
+  size_t workers = 0;
+  // simulate each repeated phase once, reusing its time and report results
+  bool memoize = false;
+  // the largest relative difference between computations of phases considered repeats
+  double tolerance = 0.0;
+  // if not null, set to the number of phases and the number that were simulated
+  size_t *phases = nullptr;
+  size_t *simulated = nullptr;
+};
+
+/**
+ * Simulate how an simsync::application would run on a simsync::system, simulating its phases concurrently.
+ *
+ * The application is split into simsync::phases at releases of a global barrier, and each phase is simulated on its
+ * own copy of the system. The result is the same as simsync::estimate, unless repeated phases are memoized with a
+ * non-zero tolerance. If the application cannot be split, the architecture has cores of different types, fewer cores
+ * than threads or sibling cores, the system charges migration penalties, pins threads or has a governor with periodic
+ * updates, or a report cannot be split, this falls back to simsync::estimate.
+ *
+ * @param app The application to run.
+ * @param sys The system to run the application on, which is not modified if the application is split.
+ * @param out The reports to generate during this simulation.
+ * @param options How to simulate the phases.
+ *
+ * @return an estimate of the application's execution time.
+ */
+std::chrono::nanoseconds estimate_phases(application const &app,
+    system &sys,
+    std::deque<std::unique_ptr<report>> const &reports,
+    phase_options const &options);
+
+/**
+ * Options for simsync::estimate_sampled.
+ */
+struct sampling_options {
+  // the number of phases to simulate before sampling the rate of progress
+  size_t warmup = 1;
+  // the fewest phases to sample before extrapolating
+  size_t samples = 4;
+  // extrapolate once the 95% confidence interval of the rate is within this fraction of the rate
+  double confidence = 0.01;
+  // if not null, set to the 95% confidence half-width of the estimate, zero if nothing was extrapolated
+  std::chrono::nanoseconds *error = nullptr;
+  // if not null, set to the number of phases and the number that were simulated
+  size_t *phases = nullptr;
+  size_t *simulated = nullptr;
+};
+
+/**
+ * Estimate how an simsync::application would run on a simsync::system by simulating some of its phases, and
+ * extrapolating the rest.
+ *
+ * The application is split into simsync::phases, which are simulated in order. After the warm-up phases, the time
+ * each phase takes per instruction is sampled. Once enough phases have been sampled and the confidence interval of
+ * the mean time per instruction is narrow enough, the simulation stops and the remaining phases are assumed to run at
+ * the mean rate. If that never happens, the whole application is simulated and the estimate is exact. The reports
+ * only cover the part of the application that was simulated.
+ *
+ * @param app The application to run.
+ * @param sys The system to run the application on.
+ * @param out The reports to generate during this simulation.
+ * @param options When to stop simulating.
+ *
+ * @return an estimate of the application's execution time.
+ */
+std::chrono::nanoseconds estimate_sampled(application const &app,
+    system &sys,
+    std::deque<std::unique_ptr<report>> const &reports,
+    sampling_options const &options);
 }
 
 #endif //SIMSYNC_SIMULATE_HPP
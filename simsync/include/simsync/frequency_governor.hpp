@@ -0,0 +1,202 @@
+#ifndef SIMSYNC_FREQUENCY_GOVERNOR_HPP
+#define SIMSYNC_FREQUENCY_GOVERNOR_HPP
+
+#include <simsync/timing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace simsync {
+class system;
+class thread_model;
+
+/**
+ * Options for the built-in frequency governors.
+ */
+struct governor_options {
+  // how often the ondemand governor measures the utilization of each core
+  picoseconds window = std::chrono::milliseconds(1);
+  // the utilization above which the ondemand governor runs a core at its fastest level
+  double up = 0.8;
+  // the utilization below which the ondemand governor steps a core down a level
+  double down = 0.3;
+  // the fraction of threads that must be waiting for the contention governor to slow every core down
+  double waiting = 0.5;
+};
+
+/**
+ * Decides the frequency level each core runs at while a thread executes on it.
+ *
+ * A simsync::system owns its governor, and copies it along with its scheduling state. The system starts each thread at
+ * its static frequency level, then asks the governor for the level of every executing thread's core after each change
+ * to the threads, and whenever the governor's next update is due. Threads whose core changes frequency part-way
+ * through a computation finish the rest of it at the new frequency.
+ */
+class frequency_governor {
+public:
+  /**
+   * Destructor.
+   */
+  virtual ~frequency_governor() = default;
+
+  /**
+   * @return A copy of this governor, including any state it has built up.
+   */
+  virtual std::unique_ptr<frequency_governor> clone() const = 0;
+
+  /**
+   * @return false if every thread always runs at its static frequency level, so the governor never needs to be asked.
+   */
+  virtual bool is_dynamic() const
+  {
+    return true;
+  }
+
+  /**
+   * Choose the frequency level of a core.
+   *
+   * @param thread_id The thread executing on the core.
+   * @param core_id The core.
+   * @param sys The operating system.
+   * @param tm The synchronization state of the threads.
+   *
+   * @return The frequency level for the core's type.
+   */
+  virtual int32_t level(int32_t thread_id, size_t core_id, system const &sys, thread_model const &tm) const = 0;
+
+  /**
+   * Observe the passing of time, before the operating system changes which threads are executing.
+   *
+   * @param current_time The present time.
+   * @param sys The operating system, as it was since the last update.
+   */
+  virtual void update(picoseconds, system const &)
+  {
+  }
+
+  /**
+   * Take over the state another governor built up, when a system takes over the scheduling state of another.
+   *
+   * @param other The other system's governor, which may be of another kind.
+   * @param current_time The time the other system had reached.
+   */
+  virtual void restore(frequency_governor const &, picoseconds)
+  {
+  }
+
+  /**
+   * @return The next time the governor needs to be asked for levels even if no thread changes state, or
+   * picoseconds::max() if there is none.
+   */
+  virtual picoseconds next_update() const
+  {
+    return picoseconds::max();
+  }
+};
+
+/**
+ * Runs every thread at its static frequency level.
+ */
+class static_governor : public frequency_governor {
+public:
+  std::unique_ptr<frequency_governor> clone() const override;
+
+  bool is_dynamic() const override
+  {
+    return false;
+  }
+
+  int32_t level(int32_t thread_id, size_t core_id, system const &sys, thread_model const &tm) const override;
+};
+
+/**
+ * Runs a thread at the fastest level of its core while it holds a lock that other threads are waiting for, and at its
+ * static level otherwise.
+ */
+class lock_boost_governor : public frequency_governor {
+public:
+  std::unique_ptr<frequency_governor> clone() const override;
+
+  int32_t level(int32_t thread_id, size_t core_id, system const &sys, thread_model const &tm) const override;
+};
+
+/**
+ * Runs every core at its slowest level while more than a fraction of the threads are blocked on synchronization or
+ * waiting for a core, and each thread at its static level otherwise.
+ */
+class contention_governor : public frequency_governor {
+public:
+  /**
+   * @param waiting The fraction of threads that must be waiting to slow cores down.
+   */
+  explicit contention_governor(double waiting);
+
+  std::unique_ptr<frequency_governor> clone() const override;
+
+  int32_t level(int32_t thread_id, size_t core_id, system const &sys, thread_model const &tm) const override;
+
+private:
+  double m_waiting;
+};
+
+/**
+ * Sets the level of each core from its utilization, as the ondemand governor of Linux does.
+ *
+ * Cores start at their fastest level. At the end of each window, a core that executed a thread for more than a
+ * fraction of the window goes to its fastest level, and a core that did for less than a lower fraction steps down a
+ * level. Static frequency levels are ignored. A governor restored from an ondemand governor with the same window
+ * continues its window, and one restored from any other governor starts a window with every core at its fastest level.
+ */
+class ondemand_governor : public frequency_governor {
+public:
+  /**
+   * @param window How often to measure utilization.
+   * @param up The utilization above which a core runs at its fastest level.
+   * @param down The utilization below which a core steps down a level.
+   */
+  ondemand_governor(picoseconds window, double up, double down);
+
+  std::unique_ptr<frequency_governor> clone() const override;
+
+  int32_t level(int32_t thread_id, size_t core_id, system const &sys, thread_model const &tm) const override;
+
+  void update(picoseconds current_time, system const &sys) override;
+
+  void restore(frequency_governor const &other, picoseconds current_time) override;
+
+  picoseconds next_update() const override
+  {
+    return m_window_end;
+  }
+
+private:
+  picoseconds m_window;
+  double m_up;
+  double m_down;
+
+  picoseconds m_last_time = picoseconds(0);
+  picoseconds m_window_end;
+
+  // for each core: how long it executed a thread in the current window
+  std::map<size_t, picoseconds> m_busy;
+  // for each core that has left its fastest level: its level
+  std::map<size_t, int32_t> m_levels;
+
+  int32_t core_level(size_t core_id, system const &sys) const;
+};
+
+/**
+ * Create a built-in frequency governor.
+ *
+ * @param name One of static, lock-boost, contention or ondemand.
+ * @param options The options of the governor.
+ *
+ * @return The governor.
+ */
+std::unique_ptr<frequency_governor> make_frequency_governor(std::string const &name, governor_options const &options);
+}
+
+#endif //SIMSYNC_FREQUENCY_GOVERNOR_HPP
@@ -0,0 +1,143 @@
+#ifndef SIMSYNC_HOT_LOCKS_HPP
+#define SIMSYNC_HOT_LOCKS_HPP
+
+#include <simsync/timing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <unordered_map>
+
+namespace simsync {
+class application;
+class event;
+class thread_model;
+
+/**
+ * What was approximated by a simsync::hot_lock_model.
+ */
+struct hot_lock_summary {
+  // the number of locks that were approximated at some point
+  size_t locks = 0;
+  // the number of acquisitions that waited for the analytic estimate instead of the lock
+  uint64_t acquisitions = 0;
+  // the total time those acquisitions waited
+  picoseconds wait = picoseconds(0);
+  // the simulated time each lock was approximated for, summed over locks
+  picoseconds duration = picoseconds(0);
+  // the number of times a lock went back to being simulated exactly
+  size_t fallbacks = 0;
+};
+
+/**
+ * Options for simsync::hot_lock_model.
+ */
+struct hot_lock_options {
+  // the acquisitions per simulated microsecond above which a lock is approximated
+  double rate = 10.0;
+  // the number of acquisitions of a lock its rate, hold and inter-arrival times are measured over
+  uint64_t window = 1000;
+  // the highest fraction of time a lock may be held for the queueing estimate to be used
+  double utilization = 0.9;
+  // the largest relative change in arrival rate or hold time between windows before a lock is simulated exactly again
+  double tolerance = 0.25;
+  // if not null, set to what was approximated
+  hot_lock_summary *summary = nullptr;
+};
+
+/**
+ * Replaces the event-by-event simulation of frequently acquired locks with a queueing model.
+ *
+ * The acquisitions of every lock are observed in windows. When a lock is acquired faster than a threshold and is held
+ * for less than a fraction of the time, it is elided in the simsync::thread_model, and each acquisition instead waits
+ * for the expected time in queue of a G/G/1 queue (Kingman's approximation), using the mean and variability of the hold
+ * and inter-arrival times measured in the last window. A waiting thread keeps its core. The lock goes back to being
+ * simulated exactly when its rate or utilization drops, or its arrival rate or hold time changes by more than a
+ * tolerance. Locks only switch when no thread holds them, and locks that are held while waiting on a condition
+ * variable are always simulated exactly.
+ */
+class hot_lock_model {
+public:
+  /**
+   * Construct a model with every lock simulated exactly.
+   *
+   * @param app The application whose locks to approximate.
+   * @param options When to approximate locks.
+   */
+  hot_lock_model(application const &app, hot_lock_options const &options);
+
+  /**
+   * Observe an event that has just been synchronized with a thread model.
+   *
+   * @param time The time of the event.
+   * @param e The event.
+   * @param tm The thread model the event was synchronized with, whose locks are elided and restored.
+   *
+   * @return The time the thread that reached the event must wait for an approximated lock, otherwise zero.
+   */
+  picoseconds update(picoseconds time, event const &e, thread_model &tm);
+
+  /**
+   * Summarize what has been approximated.
+   *
+   * @param time The present time, which ends the spans of locks that are still approximated.
+   *
+   * @return The summary.
+   */
+  hot_lock_summary summary(picoseconds time) const;
+
+private:
+  enum class lock_mode { exact, entering, approximate, leaving };
+
+  struct holder {
+    picoseconds time;
+    bool approximated;
+  };
+
+  struct lock_state {
+    lock_mode mode = lock_mode::exact;
+
+    // the window: the arrivals, and the sums and sums of squares of the inter-arrival and hold times
+    uint64_t arrivals = 0;
+    bool has_arrived = false;
+    picoseconds last_arrival = picoseconds(0);
+    double interarrival_sum = 0.0;
+    double interarrival_squares = 0.0;
+    uint64_t holds = 0;
+    double hold_sum = 0.0;
+    double hold_squares = 0.0;
+
+    // the last time the lock was released while simulated exactly
+    picoseconds last_release = picoseconds(0);
+    // for each thread holding or waiting for the lock: when it asked for the lock, or acquired it if approximated
+    std::map<int32_t, holder> holders;
+    // the number of holders that waited for the queueing estimate
+    size_t approximated_holders = 0;
+
+    // while approximated: the arrival rate and hold time in use, and the resulting wait
+    double arrival_rate = 0.0;
+    double hold_time = 0.0;
+    picoseconds wait = picoseconds(0);
+    picoseconds approximated_since = picoseconds(0);
+
+    bool was_approximated = false;
+    hot_lock_summary totals;
+  };
+
+  hot_lock_options m_options;
+
+  std::unordered_map<uint64_t, lock_state> m_locks;
+
+  // locks held while waiting on a condition variable
+  std::set<uint64_t> m_excluded;
+
+  picoseconds acquire(picoseconds time, int32_t thread_id, lock_state &state);
+
+  void release(picoseconds time, int32_t thread_id, uint64_t lock_address, lock_state &state, thread_model &tm);
+
+  void end_window(uint64_t lock_address, lock_state &state);
+};
+}
+
+#endif //SIMSYNC_HOT_LOCKS_HPP
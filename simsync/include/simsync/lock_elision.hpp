@@ -0,0 +1,57 @@
+#ifndef SIMSYNC_LOCK_ELISION_HPP
+#define SIMSYNC_LOCK_ELISION_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace simsync {
+class application;
+class system;
+
+/**
+ * The estimate for an application with one lock elided.
+ */
+struct lock_elision_result {
+  // the address of the lock
+  uint64_t lock;
+  // the number of times the lock is acquired in the trace
+  size_t acquisitions;
+  // the estimated execution time with the lock contention-free
+  std::chrono::nanoseconds execution_time;
+  // the execution time with every lock divided by the execution time with this lock elided
+  double speedup;
+};
+
+/**
+ * Options for simsync::estimate_lock_elision.
+ */
+struct lock_elision_options {
+  // only consider the locks acquired most often, or zero for every lock
+  size_t top = 0;
+  // the number of worker threads, or zero to use one per hardware thread
+  size_t workers = 0;
+};
+
+/**
+ * Estimate how much faster an simsync::application would run if each of its locks were contention-free.
+ *
+ * The application is simulated once as it is, and once for each lock with that lock elided (see
+ * simsync::thread_model::elide_lock). The simulations run on a pool of worker threads, and share the application and
+ * the core types; each has its own copy of the system.
+ *
+ * @param app The application to run.
+ * @param sys The system to run the application on, which is copied for each simulation and not run itself.
+ * @param options Which locks to elide, and how to run the simulations.
+ * @param[out] baseline If not null, set to the estimated execution time with no lock elided.
+ *
+ * @return The estimate for each lock, with the largest speedup first.
+ */
+std::vector<lock_elision_result> estimate_lock_elision(application const &app,
+    system const &sys,
+    lock_elision_options const &options,
+    std::chrono::nanoseconds *baseline = nullptr);
+}
+
+#endif //SIMSYNC_LOCK_ELISION_HPP
@@ -0,0 +1,67 @@
+#ifndef SIMSYNC_MONTE_CARLO_HPP
+#define SIMSYNC_MONTE_CARLO_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace simsync {
+class application;
+class system;
+
+/**
+ * Options for simsync::estimate_replicates.
+ */
+struct monte_carlo_options {
+  // the number of replicates to simulate
+  size_t replicates = 100;
+  // the seed of the first replicate, which is incremented for each subsequent replicate
+  uint64_t seed = 0;
+  // the number of worker threads, or zero to use one per hardware thread
+  size_t workers = 0;
+};
+
+/**
+ * The distribution of execution times over the replicates of a Monte Carlo estimate.
+ */
+struct monte_carlo_result {
+  // the execution time of each replicate, in order of seed
+  std::vector<std::chrono::nanoseconds> execution_times;
+  // the mean execution time
+  std::chrono::nanoseconds mean;
+  // the sample standard deviation of the execution time
+  std::chrono::nanoseconds standard_deviation;
+  // the 95% confidence interval of the mean execution time
+  std::chrono::nanoseconds confidence_lower;
+  std::chrono::nanoseconds confidence_upper;
+};
+
+/**
+ * Estimate the distribution of the execution time of an simsync::application when CPIs vary between computations.
+ *
+ * Each replicate samples the CPI of every computation from a normal distribution with the mean and standard deviation
+ * of the thread's CPI on its core (see simsync::simulation::sample_cpi). Threads without a standard deviation in the
+ * architecture configuration always run at their mean CPI. The replicates run on a pool of worker threads and share
+ * the application and the core types; each has only its own simsync::system and synchronization state.
+ *
+ * @param app The application to run.
+ * @param sys The system to run the application on, which is copied for each replicate and not run itself.
+ * @param options How many replicates to run, and how.
+ *
+ * @return The distribution of execution times.
+ */
+monte_carlo_result estimate_replicates(application const &app, system const &sys, monte_carlo_options const &options);
+
+/**
+ * Get a percentile of the execution times of a Monte Carlo estimate, using the nearest rank.
+ *
+ * @param result The result of simsync::estimate_replicates, with at least one replicate.
+ * @param fraction The percentile as a fraction between zero and one.
+ *
+ * @return The smallest execution time that at least the fraction of replicates do not exceed.
+ */
+std::chrono::nanoseconds percentile(monte_carlo_result const &result, double fraction);
+}
+
+#endif //SIMSYNC_MONTE_CARLO_HPP
@@ -0,0 +1,23 @@
+#ifndef SIMSYNC_PARALLEL_HPP
+#define SIMSYNC_PARALLEL_HPP
+
+#include <cstddef>
+#include <functional>
+
+namespace simsync {
+
+/**
+ * Run a task for every index on a pool of worker threads.
+ *
+ * Workers take the next index from a shared counter as soon as they are idle, so long tasks do not hold up short
+ * ones. If a task throws, the remaining indices are skipped and the first exception is rethrown once all workers have
+ * stopped.
+ *
+ * @param count The number of tasks.
+ * @param workers The number of worker threads, or zero to use one per hardware thread.
+ * @param task The task to run, given the index of the task.
+ */
+void parallel_for(size_t count, size_t workers, std::function<void(size_t)> const &task);
+}
+
+#endif //SIMSYNC_PARALLEL_HPP
@@ -0,0 +1,94 @@
+#ifndef SIMSYNC_PHASES_HPP
+#define SIMSYNC_PHASES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <vector>
+
+namespace simsync {
+class application;
+
+/**
+ * The phases of an application.
+ *
+ * A global barrier is a barrier that every thread of the application waits at. When it is released, all threads start
+ * a new computation at the same time. If no lock, condition variable, barrier or thread lifetime state is carried
+ * across a release, the time until a later release depends only on the events in between, not on the absolute time.
+ * The application is split at each such release into phases that can be simulated independently.
+ */
+class phases {
+public:
+  /**
+   * Split an application into phases.
+   *
+   * @param app The application to split.
+   */
+  explicit phases(application const &app);
+
+  /**
+   * @return The number of phases, which is one if the application cannot be split.
+   */
+  size_t size() const
+  {
+    return m_starts.size();
+  }
+
+  /**
+   * @return The address of the global barrier that separates phases.
+   */
+  uint64_t barrier() const
+  {
+    return m_barrier;
+  }
+
+  /**
+   * Get where each thread starts in a phase.
+   *
+   * @param index The phase.
+   *
+   * @return For each thread, the index of its first computation in the phase. The first phase starts at the beginning
+   * of the application and has no entries.
+   */
+  std::map<int32_t, size_t> const &start(size_t index) const
+  {
+    return m_starts.at(index);
+  }
+
+  /**
+   * Get how many times the global barrier is released before a phase ends.
+   *
+   * @param index The phase.
+   *
+   * @return The number of releases, or zero for the last phase, which runs until the application finishes.
+   */
+  size_t releases(size_t index) const
+  {
+    return m_releases.at(index);
+  }
+
+  /**
+   * Find phases that repeat an earlier phase.
+   *
+   * A phase repeats another when every thread has the same sequence of events and each of its computations is within
+   * a relative tolerance of the other's. The phases of one run share core types and frequencies, so repeated phases
+   * take the same time. The first and last phases start and end differently from all others, so never repeat.
+   *
+   * @param app The application these phases were split from.
+   * @param tolerance The largest relative difference between repeated computations, zero for an exact match.
+   *
+   * @return For each phase, the index of the first phase it repeats, or its own index.
+   */
+  std::vector<size_t> find_repeats(application const &app, double tolerance) const;
+
+private:
+  uint64_t m_barrier = 0;
+
+  std::deque<std::map<int32_t, size_t>> m_starts;
+
+  std::deque<size_t> m_releases;
+};
+}
+
+#endif //SIMSYNC_PHASES_HPP
@@ -0,0 +1,41 @@
+#ifndef SIMSYNC_COMPLETION_TIME_HPP
+#define SIMSYNC_COMPLETION_TIME_HPP
+
+#include <simsync/reports/report.hpp>
+
+#include <cstddef>
+#include <map>
+
+namespace simsync {
+
+/**
+ * Records when each of the applications scheduled together processes its last event.
+ */
+class completion_time : public report {
+public:
+  explicit completion_time(std::string const &output_file);
+
+  completion_time() = default;
+
+  ~completion_time() override;
+
+  void update(picoseconds current_time, event *e) override;
+
+  std::unique_ptr<report> split(system const &sys) const override;
+
+  void merge(report const &part, picoseconds offset) override;
+
+  /**
+   * @return The time of the last event of each application that has processed an event, indexable by application.
+   */
+  std::map<size_t, picoseconds> const &completion_times() const
+  {
+    return m_completion_times;
+  }
+
+private:
+  std::map<size_t, picoseconds> m_completion_times;
+};
+}
+
+#endif //SIMSYNC_COMPLETION_TIME_HPP
@@ -0,0 +1,90 @@
+#ifndef SIMSYNC_CPI_SENSITIVITY_HPP
+#define SIMSYNC_CPI_SENSITIVITY_HPP
+
+#include <simsync/reports/report.hpp>
+
+#include <cstddef>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace simsync {
+class application;
+class system;
+
+/**
+ * The sensitivity of the execution time to the CPI of each thread.
+ *
+ * Each thread's execution is split into segments wherever it starts executing or starts another thread. A segment
+ * that starts because another thread released a lock, a barrier, a joined thread or a core depends on the segment
+ * that released it. Following these dependencies back from the last event gives the critical path, and each thread's
+ * computation on it is how much the execution time grows as that thread's CPI grows.
+ *
+ * For every thread, the report contains its computation time on the critical path (i.e., the change in execution time
+ * for a relative change in its CPI), the share of the execution time that represents, and the change in execution time
+ * for an absolute change of one in its CPI. All times are in nanoseconds.
+ *
+ * Each computation is timed with the thread's configured CPI, at the frequency and sibling activity of its core when
+ * the computation ends. The sensitivity is therefore exact, for small changes, only when CPIs are not sampled and the
+ * speed of a core does not change during a computation or depend on when other threads run, i.e., with static
+ * frequencies, no busy siblings and no preemption. Otherwise, it is an approximation.
+ */
+class cpi_sensitivity : public report {
+public:
+  explicit cpi_sensitivity(std::string const &output_file, application const &app, system const &sys);
+
+  ~cpi_sensitivity() override;
+
+  void update(picoseconds current_time, event *e) override;
+
+  /**
+   * @return For each thread, its computation time on the critical path so far.
+   */
+  std::map<int32_t, picoseconds> critical_time() const;
+
+  /**
+   * @return The time of the last event so far.
+   */
+  picoseconds total_time() const
+  {
+    return m_last_time;
+  }
+
+private:
+  struct segment {
+    int32_t thread_id;
+    // the segment this one waited for, or none
+    size_t predecessor;
+    // the time spent computing
+    picoseconds time;
+    // the change in time for an increase of one in the thread's CPI
+    double derivative;
+  };
+
+  static constexpr size_t none = static_cast<size_t>(-1);
+
+  application const &m_application;
+
+  system const &m_system;
+
+  picoseconds m_last_time;
+
+  std::vector<segment> m_segments;
+
+  // for each thread: the segment it is presently in
+  std::map<int32_t, size_t> m_current_segment;
+
+  // for each thread: the index of its next event
+  std::map<int32_t, size_t> m_next_index;
+
+  // threads executing at the last event, and the thread the event belongs to
+  std::set<int32_t> m_executing;
+  int32_t m_last_thread;
+
+  size_t start_segment(int32_t thread_id, size_t predecessor);
+
+  void walk(std::map<int32_t, picoseconds> *time, std::map<int32_t, double> *derivative) const;
+};
+}
+
+#endif //SIMSYNC_CPI_SENSITIVITY_HPP
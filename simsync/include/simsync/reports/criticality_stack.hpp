@@ -1,10 +1,9 @@
 #ifndef SIMSYNC_CRITICALITY_STACK_HPP
 #define SIMSYNC_CRITICALITY_STACK_HPP
 
+#include <simsync/criticality_accumulator.hpp>
 #include <simsync/reports/report.hpp>
 
-#include <map>
-
 namespace simsync {
 class system;
 
@@ -12,16 +11,22 @@ class criticality_stack : public report {
 public:
   explicit criticality_stack(std::string const &output_file, const system &system);
 
+  explicit criticality_stack(const system &system);
+
   ~criticality_stack() override;
 
-  void update(std::chrono::nanoseconds current_time, event *e) override;
+  void update(picoseconds current_time, event *e) override;
+
+  void preempt(picoseconds current_time) override;
+
+  std::unique_ptr<report> split(system const &sys) const override;
+
+  void merge(report const &part, picoseconds offset) override;
 
 private:
   system const &m_system;
 
-  std::chrono::nanoseconds m_last_time;
-
-  std::map<int32_t, int64_t> m_criticality;
+  criticality_accumulator m_criticality;
 };
 }
 
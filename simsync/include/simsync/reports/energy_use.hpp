@@ -0,0 +1,30 @@
+#ifndef SIMSYNC_ENERGY_USE_HPP
+#define SIMSYNC_ENERGY_USE_HPP
+
+#include <simsync/reports/report.hpp>
+
+namespace simsync {
+class system;
+
+/**
+ * Records the energy used by each core and each thread, the total energy, and the energy-delay product of the run.
+ *
+ * The energy is accumulated by the simsync::system as threads start and stop, so this report only keeps the time of the
+ * last event, which ends the run.
+ */
+class energy_use : public report {
+public:
+  explicit energy_use(std::string const &output_file, system const &sys);
+
+  ~energy_use() override;
+
+  void update(picoseconds current_time, event *e) override;
+
+private:
+  system const &m_system;
+
+  picoseconds m_last_time;
+};
+}
+
+#endif //SIMSYNC_ENERGY_USE_HPP
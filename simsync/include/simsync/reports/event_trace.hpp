@@ -14,9 +14,9 @@ public:
   {
   }
 
-  void update(std::chrono::nanoseconds const current_time, event *e) override
+  void update(picoseconds const current_time, event *e) override
   {
-    m_stream << e->get_thread_id() << " " << current_time.count() << " " << *e << std::endl;
+    m_stream << e->get_thread_id() << " " << std::chrono::duration_cast<std::chrono::nanoseconds>(current_time).count() << " " << *e << std::endl;
   }
 };
 }
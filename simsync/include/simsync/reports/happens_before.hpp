@@ -0,0 +1,111 @@
+#ifndef SIMSYNC_HAPPENS_BEFORE_HPP
+#define SIMSYNC_HAPPENS_BEFORE_HPP
+
+#include <simsync/reports/report.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace simsync {
+class application;
+class architecture;
+class system;
+
+/**
+ * The result of replaying a simsync::happens_before graph.
+ */
+struct replay_result {
+  // the estimated execution time
+  std::chrono::nanoseconds execution_time;
+  // the number of times a lock would have been requested in a different order
+  size_t reordered_locks;
+};
+
+/**
+ * The order in which a simulation resolved synchronization, as a dependency graph.
+ *
+ * Each event is a node that completes once the computation leading up to it is done. The computation starts when the
+ * thread's previous event completes, and when every event it depends on has completed: the event that woke the thread
+ * or gave it a core, the previous release of a lock it acquires, the finish of a thread it joins, and every arrival at
+ * a barrier it waits at.
+ *
+ * Replaying the graph with other CPIs and frequencies is a single longest-path pass over the nodes, which gives the
+ * same result as a simulation as long as the order of synchronization does not change. On the architecture and system
+ * the graph was captured on, the result is exact. Replays count the locks that would have been requested in a
+ * different order, in which case the result is only an approximation. Each computation is assumed to run on the same
+ * core as it was captured on. Migration penalties are not part of the graph, so graphs cannot be captured or replayed
+ * on systems that charge them.
+ *
+ * The report contains the graph, with a row per node listing its thread (or -1 for the release of a barrier), core,
+ * instruction count, previous node of the same thread, and the nodes it depends on.
+ */
+class happens_before : public report {
+public:
+  explicit happens_before(std::string const &output_file, application const &app, system const &sys);
+
+  ~happens_before() override;
+
+  void update(picoseconds current_time, event *e) override;
+
+  /**
+   * Estimate the execution time with the synchronization order of the captured simulation.
+   *
+   * @param arch The architecture to take CPIs and frequencies from, which must have at least as many cores.
+   * @param sys The system to take static frequency levels from.
+   *
+   * @return The estimated execution time.
+   * @throws std::runtime_error If either system charges migration penalties.
+   */
+  replay_result replay(architecture const &arch, system const &sys) const;
+
+private:
+  static constexpr uint32_t none = static_cast<uint32_t>(-1);
+
+  application const &m_application;
+
+  system const &m_system;
+
+  // for each node: its thread and core, as an index into m_slots
+  std::vector<uint32_t> m_slot;
+  // for each node: the instructions leading up to it
+  std::vector<uint64_t> m_instructions;
+  // for each node: the previous node of the same thread
+  std::vector<uint32_t> m_previous;
+  // for each node: where its dependencies start in m_dependencies, with a final entry for the end
+  std::vector<uint32_t> m_first_dependency;
+  std::vector<uint32_t> m_dependencies;
+
+  // each distinct pair of core and thread, where the first pair has no thread (for barrier releases)
+  std::vector<std::pair<size_t, int32_t>> m_slots;
+  std::map<std::pair<size_t, int32_t>, uint32_t> m_slot_index;
+
+  // consecutive requests of the same lock
+  std::vector<std::pair<uint32_t, uint32_t>> m_lock_requests;
+
+  // capture state: for each thread, its next event index, its last node and its pending dependencies
+  std::map<int32_t, size_t> m_next_index;
+  std::map<int32_t, uint32_t> m_last_node;
+  std::map<int32_t, std::vector<uint32_t>> m_pending;
+
+  // capture state: the last release and request of each lock, arrivals at each barrier, finished threads
+  std::map<uint64_t, uint32_t> m_last_release;
+  std::map<uint64_t, uint32_t> m_last_request;
+  std::map<uint64_t, std::vector<uint32_t>> m_arrivals;
+  std::map<int32_t, uint32_t> m_finish;
+
+  // capture state: threads executing at the last event, and the node of the last event
+  std::set<int32_t> m_executing;
+  uint32_t m_last_event;
+
+  uint32_t add_node(uint32_t slot, uint64_t instructions, uint32_t previous, std::vector<uint32_t> const &dependencies);
+
+  uint32_t get_slot(size_t core_id, int32_t thread_id);
+};
+}
+
+#endif //SIMSYNC_HAPPENS_BEFORE_HPP
@@ -0,0 +1,31 @@
+#ifndef SIMSYNC_MIGRATIONS_HPP
+#define SIMSYNC_MIGRATIONS_HPP
+
+#include <simsync/reports/report.hpp>
+
+#include <set>
+
+namespace simsync {
+class system;
+
+/**
+ * Records how many times each thread started executing on a different core than it last ran on, and the instructions
+ * it executed to warm up those cores.
+ */
+class migrations : public report {
+public:
+  explicit migrations(std::string const &output_file, system const &sys);
+
+  ~migrations() override;
+
+  void update(picoseconds current_time, event *e) override;
+
+private:
+  system const &m_system;
+
+  // the threads that have processed an event
+  std::set<int32_t> m_threads;
+};
+}
+
+#endif //SIMSYNC_MIGRATIONS_HPP
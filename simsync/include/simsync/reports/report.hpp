@@ -1,11 +1,14 @@
 #ifndef SIMSYNC_REPORT_HPP
 #define SIMSYNC_REPORT_HPP
 
-#include <chrono>
+#include <simsync/timing.hpp>
+
 #include <fstream>
+#include <memory>
 
 namespace simsync {
 class event;
+class system;
 
 class report {
 public:
@@ -15,9 +18,47 @@ public:
 
   virtual ~report() = default;
 
-  virtual void update(std::chrono::nanoseconds current_time, event *e) = 0;
+  virtual void update(picoseconds current_time, event *e) = 0;
+
+  /**
+   * Observe a scheduler tick that is about to preempt threads, which happens between events.
+   *
+   * @param current_time The time of the tick.
+   */
+  virtual void preempt(picoseconds)
+  {
+  }
+
+  /**
+   * Create an empty report of the same kind, which observes another system and writes no output.
+   *
+   * Parts of a simulation that run separately each update their own split report, which are then merged back.
+   *
+   * @param sys The system the part of the simulation runs on.
+   *
+   * @return The new report, or nullptr if the report depends on the order of events across parts.
+   */
+  virtual std::unique_ptr<report> split(system const &) const
+  {
+    return nullptr;
+  }
+
+  /**
+   * Add the results of a report created by split.
+   *
+   * @param part The report of a part of the simulation.
+   * @param offset The time at which the part started.
+   */
+  virtual void merge(report const &, picoseconds)
+  {
+  }
 
 protected:
+  /**
+   * Construct a report that writes no output.
+   */
+  report() = default;
+
   std::ofstream m_stream;
 };
 }
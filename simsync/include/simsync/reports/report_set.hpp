@@ -0,0 +1,84 @@
+#ifndef SIMSYNC_REPORT_SET_HPP
+#define SIMSYNC_REPORT_SET_HPP
+
+#include <simsync/timing.hpp>
+
+#include <initializer_list>
+#include <tuple>
+#include <utility>
+
+namespace simsync {
+class event;
+class criticality_stack;
+class time_stack;
+
+/**
+ * A set of reports whose types are known at compile time.
+ *
+ * Each report is updated with a direct, rather than virtual, call. An empty set does nothing, so a simulation that
+ * only estimates the execution time contains no report code.
+ *
+ * @tparam Reports The types of the reports.
+ */
+template <typename... Reports>
+class report_set {
+public:
+  /**
+   * @param reports The reports to update, which must outlive this set.
+   */
+  explicit report_set(Reports &... reports) : m_reports(reports...)
+  {
+  }
+
+  void update(picoseconds const current_time, event *const e)
+  {
+    update(current_time, e, std::index_sequence_for<Reports...>());
+  }
+
+  void preempt(picoseconds const current_time)
+  {
+    preempt(current_time, std::index_sequence_for<Reports...>());
+  }
+
+private:
+  std::tuple<Reports &...> m_reports;
+
+  template <size_t... Index>
+  void update(picoseconds const current_time, event *const e, std::index_sequence<Index...>)
+  {
+    (void)current_time;
+    (void)e;
+    (void)std::initializer_list<int>{0, (update_one<Reports>(std::get<Index>(m_reports), current_time, e), 0)...};
+  }
+
+  template <typename Report>
+  static void update_one(Report &r, picoseconds const current_time, event *const e)
+  {
+    r.Report::update(current_time, e);
+  }
+
+  template <size_t... Index>
+  void preempt(picoseconds const current_time, std::index_sequence<Index...>)
+  {
+    (void)current_time;
+    (void)std::initializer_list<int>{0, (preempt_one<Reports>(std::get<Index>(m_reports), current_time), 0)...};
+  }
+
+  template <typename Report>
+  static void preempt_one(Report &r, picoseconds const current_time)
+  {
+    r.Report::preempt(current_time);
+  }
+};
+
+/**
+ * Apply a macro to each report set that simsync::simulation::run and simsync::estimate are compiled for.
+ */
+#define SIMSYNC_FOR_EACH_REPORT_SET(X)                                                             \
+  X()                                                                                              \
+  X(time_stack)                                                                                    \
+  X(criticality_stack)                                                                             \
+  X(time_stack, criticality_stack)
+}
+
+#endif //SIMSYNC_REPORT_SET_HPP
@@ -16,9 +16,9 @@ public:
   {
   }
 
-  void update(std::chrono::nanoseconds const current_time, event *e) override
+  void update(picoseconds const current_time, event *e) override
   {
-    m_stream << e->get_thread_id() << " " << current_time.count() << " " << *e << " ";
+    m_stream << e->get_thread_id() << " " << std::chrono::duration_cast<std::chrono::nanoseconds>(current_time).count() << " " << *e << " ";
     print_threads("running", m_system.executing_threads());
     print_threads("sleeping", m_system.sleeping_threads());
     print_threads("waiting", m_system.waiting_threads());
@@ -12,20 +12,28 @@ class time_stack : public report {
 public:
   explicit time_stack(const std::string &output_file, system const &sys);
 
+  explicit time_stack(system const &sys);
+
   ~time_stack() override;
 
-  void update(std::chrono::nanoseconds current_time, event *e) override;
+  void update(picoseconds current_time, event *e) override;
+
+  void preempt(picoseconds current_time) override;
+
+  std::unique_ptr<report> split(system const &sys) const override;
+
+  void merge(report const &part, picoseconds offset) override;
 
 private:
   struct wrapper {
-    std::chrono::nanoseconds compute;
-    std::chrono::nanoseconds sync;
-    std::chrono::nanoseconds wait;
+    picoseconds compute;
+    picoseconds sync;
+    picoseconds wait;
   };
 
   system const &m_system;
 
-  std::chrono::nanoseconds m_last_time;
+  picoseconds m_last_time;
 
   std::map<int32_t, wrapper> m_wrappers;
 };
@@ -0,0 +1,147 @@
+#ifndef SIMSYNC_SCHEDULER_POLICY_HPP
+#define SIMSYNC_SCHEDULER_POLICY_HPP
+
+#include <simsync/criticality_accumulator.hpp>
+#include <simsync/timing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace simsync {
+class system;
+
+/**
+ * Decides which core a thread runs on, and which waiting thread runs when a core becomes available.
+ *
+ * A simsync::system owns its policy, and copies it along with its scheduling state.
+ */
+class scheduler_policy {
+public:
+  /**
+   * Destructor.
+   */
+  virtual ~scheduler_policy() = default;
+
+  /**
+   * @return A copy of this policy, including any state it has built up.
+   */
+  virtual std::unique_ptr<scheduler_policy> clone() const = 0;
+
+  /**
+   * Choose a core for a thread.
+   *
+   * @param thread_id The thread to run.
+   * @param available The available cores, in the order they became available. There is at least one.
+   * @param sys The operating system.
+   *
+   * @return The position of the chosen core in available.
+   */
+  virtual size_t choose_core(int32_t thread_id, std::deque<size_t> const &available, system const &sys) const = 0;
+
+  /**
+   * Choose the waiting thread to run on a core that has become available.
+   *
+   * @param waiting The threads waiting for a core, in the order they started waiting. There is at least one.
+   * @param sys The operating system.
+   *
+   * @return The position of the chosen thread in waiting. By default, the thread that has waited longest.
+   */
+  virtual size_t choose_thread(std::deque<int32_t> const &, system const &) const
+  {
+    return 0;
+  }
+
+  /**
+   * Observe the passing of time, before the operating system changes which threads are executing.
+   *
+   * @param current_time The present time.
+   * @param sys The operating system, as it was since the last update.
+   */
+  virtual void update(picoseconds, system const &)
+  {
+  }
+
+  /**
+   * Take over the state another policy built up, when a system takes over the scheduling state of another.
+   *
+   * @param other The other system's policy, which may be of another kind.
+   * @param current_time The time the other system had reached.
+   */
+  virtual void restore(scheduler_policy const &, picoseconds)
+  {
+  }
+};
+
+/**
+ * Runs threads on the core that became available first, and the thread that has waited longest first.
+ */
+class fifo_policy : public scheduler_policy {
+public:
+  std::unique_ptr<scheduler_policy> clone() const override;
+
+  size_t choose_core(int32_t thread_id, std::deque<size_t> const &available, system const &sys) const override;
+};
+
+/**
+ * Runs each thread on the available core that executes its instructions fastest, given its CPI on each core type and
+ * its static frequency level. Ties go to the core that became available first.
+ */
+class fastest_core_policy : public scheduler_policy {
+public:
+  std::unique_ptr<scheduler_policy> clone() const override;
+
+  size_t choose_core(int32_t thread_id, std::deque<size_t> const &available, system const &sys) const override;
+};
+
+/**
+ * Runs the most critical threads first, and on the fastest cores.
+ *
+ * The criticality of a thread is measured as it runs, as by simsync::criticality_stack (see
+ * simsync::criticality_accumulator). The most critical waiting
+ * thread gets the next available core. A thread at least as critical as the average thread gets the fastest available
+ * core, and any other thread gets the slowest, to keep fast cores free for critical threads. A policy restored from
+ * another criticality policy keeps measuring from where it left off, and one restored from any other policy starts
+ * measuring at the restore time.
+ */
+class criticality_policy : public scheduler_policy {
+public:
+  std::unique_ptr<scheduler_policy> clone() const override;
+
+  size_t choose_core(int32_t thread_id, std::deque<size_t> const &available, system const &sys) const override;
+
+  size_t choose_thread(std::deque<int32_t> const &waiting, system const &sys) const override;
+
+  void update(picoseconds current_time, system const &sys) override;
+
+  void restore(scheduler_policy const &other, picoseconds current_time) override;
+
+private:
+  criticality_accumulator m_criticality;
+};
+
+/**
+ * Runs each thread on the core it last ran on (see simsync::system::last_cores) if it is available, otherwise as
+ * simsync::fifo_policy does.
+ */
+class sticky_policy : public scheduler_policy {
+public:
+  std::unique_ptr<scheduler_policy> clone() const override;
+
+  size_t choose_core(int32_t thread_id, std::deque<size_t> const &available, system const &sys) const override;
+};
+
+/**
+ * Create a built-in scheduler policy.
+ *
+ * @param name One of fifo, fastest-core, criticality or sticky.
+ *
+ * @return The policy.
+ */
+std::unique_ptr<scheduler_policy> make_scheduler_policy(std::string const &name);
+}
+
+#endif //SIMSYNC_SCHEDULER_POLICY_HPP
@@ -0,0 +1,317 @@
+#ifndef SIMSYNC_SIMULATION_HPP
+#define SIMSYNC_SIMULATION_HPP
+
+#include <simsync/checkpoint.hpp>
+#include <simsync/cpi_sampler.hpp>
+#include <simsync/hot_locks.hpp>
+#include <simsync/system.hpp>
+#include <simsync/thread_tracker.hpp>
+#include <simsync/timing.hpp>
+#include <simsync/reports/report_set.hpp>
+#include <simsync/synchronization/thread_model.hpp>
+#include <simsync/synchronization/transition.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace simsync {
+class application;
+class event;
+class report;
+
+/**
+ * The progress of a simsync::simulation.
+ */
+struct progress {
+  // the number of events processed
+  uint64_t events;
+  // the simulated time of the last event processed
+  std::chrono::nanoseconds time;
+  // the events processed per second of wall time since progress started being reported
+  double events_per_second;
+};
+
+/**
+ * A simulation of an simsync::application on a simsync::system, which can be run a part at a time.
+ *
+ * The simulation has its own synchronization state, so many simulations of the same application can run at once on
+ * different systems. It can be stopped after a number of events or at a simulated time and continued later, and can
+ * be cancelled from another thread.
+ */
+class simulation {
+public:
+  /**
+   * Construct a simulation with the master thread of each application (see simsync::application::masters) scheduled
+   * for execution.
+   *
+   * @param app The application to run.
+   * @param sys The system to run the application on.
+   * @param reports The reports to generate during this simulation.
+   */
+  simulation(application const &app, system &sys, std::deque<std::unique_ptr<report>> const &reports);
+
+  /**
+   * Construct a simulation with no reports, with the master thread of each application scheduled for execution.
+   *
+   * Reports can still be updated by running with a simsync::report_set.
+   *
+   * @param app The application to run.
+   * @param sys The system to run the application on.
+   */
+  simulation(application const &app, system &sys);
+
+  /**
+   * Construct a simulation with threads scheduled part-way through the application.
+   *
+   * @param app The application to run.
+   * @param sys The system to run the application on.
+   * @param reports The reports to generate during this simulation.
+   * @param start For each thread to schedule, the index of the computation it starts from.
+   */
+  simulation(application const &app,
+      system &sys,
+      std::deque<std::unique_ptr<report>> const &reports,
+      std::map<int32_t, size_t> const &start);
+
+  /**
+   * Continue a simulation from a simsync::checkpoint, possibly on a differently configured system.
+   *
+   * The system takes over the checkpoint's assignment of threads to cores, but keeps its own core types and static
+   * frequencies. Threads that were part-way through a computation finish the work that was left at their new speed.
+   * The reports start from the results saved in the checkpoint, and CPIs are sampled with the checkpoint's seed if its
+   * simulation sampled them.
+   *
+   * @param app The application the checkpoint was taken from.
+   * @param from The checkpoint to continue from.
+   * @param sys The system to continue on, which must have as many cores as the checkpoint's and not have run before.
+   * @param reports The reports to generate during this simulation, which should not have been updated before.
+   */
+  simulation(application const &app,
+      checkpoint const &from,
+      system &sys,
+      std::deque<std::unique_ptr<report>> const &reports);
+
+  // the reports are kept by reference, so must not be temporaries
+  simulation(application const &, system &, std::deque<std::unique_ptr<report>> &&) = delete;
+  simulation(application const &, system &, std::deque<std::unique_ptr<report>> &&, std::map<int32_t, size_t> const &) =
+      delete;
+  simulation(application const &, checkpoint const &, system &, std::deque<std::unique_ptr<report>> &&) = delete;
+
+  simulation(simulation const &) = delete;
+
+  simulation &operator=(simulation const &) = delete;
+
+  /**
+   * Process a number of events.
+   *
+   * @param events The most events to process.
+   *
+   * @return true if the application has finished.
+   */
+  bool step(uint64_t events);
+
+  /**
+   * Process every event that happens at or before a simulated time.
+   *
+   * @param time The time to stop at.
+   *
+   * @return true if the application has finished.
+   */
+  bool run_until(picoseconds time);
+
+  /**
+   * Process events until a barrier has been released a number of times.
+   *
+   * @param barrier The address of the barrier.
+   * @param releases The number of releases to stop after.
+   *
+   * @return true if the application has finished.
+   */
+  bool run_until_release(uint64_t barrier, size_t releases);
+
+  /**
+   * Process events until the application finishes, or the simulation is cancelled.
+   *
+   * @return the time of the last event processed, which is the execution time if the application has finished.
+   */
+  std::chrono::nanoseconds run();
+
+  /**
+   * Process events until the application finishes, or the simulation is cancelled, updating a set of reports known at
+   * compile time instead of this simulation's reports.
+   *
+   * This is only compiled for the report sets listed by SIMSYNC_FOR_EACH_REPORT_SET. The reports are not included in
+   * checkpoints.
+   *
+   * @param reports The reports to generate.
+   *
+   * @return the time of the last event processed, which is the execution time if the application has finished.
+   */
+  template <typename... Reports>
+  std::chrono::nanoseconds run(report_set<Reports...> &reports);
+
+  /**
+   * @return true if no thread can make progress, i.e., the application has finished.
+   */
+  bool finished() const
+  {
+    return m_threads.executing() == 0;
+  }
+
+  /**
+   * @return The simulated time of the last event processed.
+   */
+  picoseconds time() const
+  {
+    return m_time;
+  }
+
+  /**
+   * @return The number of events processed.
+   */
+  uint64_t events() const
+  {
+    return m_events;
+  }
+
+  /**
+   * Report progress while running.
+   *
+   * @param callback Called with the progress made, from the thread running the simulation.
+   * @param interval The wall time between calls.
+   */
+  void on_progress(std::function<void(progress const &)> callback, std::chrono::milliseconds interval);
+
+  /**
+   * Take checkpoints while running.
+   *
+   * @param options When to take checkpoints, and where to put them.
+   */
+  void take_checkpoints(checkpoint_options const &options);
+
+  /**
+   * Sample the CPI of each computation from the distribution of its thread's CPI on its core, instead of using the
+   * mean. Simulations with the same seed take the same time.
+   *
+   * @param seed The seed of the samples.
+   */
+  void sample_cpi(uint64_t seed);
+
+  /**
+   * Make a lock contention-free for the rest of this simulation (see simsync::thread_model::elide_lock).
+   *
+   * @param lock_address The address the lock is located at.
+   */
+  void elide_lock(uint64_t lock_address)
+  {
+    m_thread_model.elide_lock(lock_address);
+  }
+
+  /**
+   * Approximate the waits for frequently acquired locks with a queueing model for the rest of this simulation (see
+   * simsync::hot_lock_model). Threads are always timed one event at a time, and no checkpoints can be taken.
+   *
+   * @param options When to approximate locks.
+   */
+  void approximate_hot_locks(hot_lock_options const &options);
+
+  /**
+   * @return What has been approximated by approximate_hot_locks.
+   */
+  hot_lock_summary hot_locks() const
+  {
+    return m_hot_locks != nullptr ? m_hot_locks->summary(m_time) : hot_lock_summary{};
+  }
+
+  /**
+   * Stop running as soon as possible. This may be called from any thread, including a progress callback.
+   */
+  void cancel()
+  {
+    m_cancelled.store(true, std::memory_order_relaxed);
+  }
+
+  /**
+   * @return true if the simulation was cancelled.
+   */
+  bool cancelled() const
+  {
+    return m_cancelled.load(std::memory_order_relaxed);
+  }
+
+private:
+  using clock = std::chrono::steady_clock;
+
+  application const &m_app;
+
+  thread_model m_thread_model;
+
+  system &m_system;
+
+  std::deque<std::unique_ptr<report>> const &m_reports;
+
+  thread_tracker m_threads;
+
+  picoseconds m_time;
+
+  // the number of events processed
+  uint64_t m_events = 0;
+
+  // storage for the system's scheduling changes
+  std::vector<schedule_change> m_changes;
+
+  std::atomic<bool> m_cancelled;
+
+  std::unique_ptr<cpi_sampler> m_sampler;
+
+  std::unique_ptr<hot_lock_model> m_hot_locks;
+
+  // where the current run stops: after an event, after a time, or after a barrier is released a number of times
+  uint64_t m_event_limit = std::numeric_limits<uint64_t>::max();
+  picoseconds m_time_limit = picoseconds::max();
+  uint64_t m_stop_barrier = 0;
+  size_t m_stop_releases = 0;
+
+  checkpoint_options m_checkpoints;
+  picoseconds m_next_checkpoint_time = picoseconds(0);
+  uint64_t m_next_checkpoint_events = 0;
+
+  std::function<void(progress const &)> m_progress;
+  std::chrono::milliseconds m_progress_interval = std::chrono::milliseconds(0);
+  uint64_t m_next_progress_poll = 0;
+  uint64_t m_progress_start_events = 0;
+  clock::time_point m_progress_start;
+  clock::time_point m_last_progress;
+
+  void start(std::map<int32_t, size_t> const &start);
+
+  void process();
+
+  template <typename Observer>
+  void process(Observer &observer);
+
+  bool should_stop();
+
+  void report_progress();
+
+  void checkpoint_if_due();
+
+  template <typename Observer>
+  transition synchronize(Observer &observer, event *current_event);
+
+  template <typename Observer>
+  bool run_serial(Observer &observer, int32_t thread_id, event **last_event, transition *state_changes);
+
+  void apply(transition const &state_changes);
+};
+}
+
+#endif //SIMSYNC_SIMULATION_HPP
@@ -0,0 +1,69 @@
+#ifndef SIMSYNC_SWEEP_HPP
+#define SIMSYNC_SWEEP_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace simsync {
+class application;
+
+/**
+ * The estimate for one architecture configuration of a sweep.
+ */
+struct sweep_result {
+  // the architecture configuration file
+  std::string config;
+  // the number of cores in the architecture
+  size_t cores;
+  // the estimated execution time of the application
+  std::chrono::nanoseconds execution_time;
+  // false if the simulation was given up at the deadline, in which case the execution time is a lower bound
+  bool complete;
+};
+
+/**
+ * Options for simsync::sweep.
+ */
+struct sweep_options {
+  // the number of worker threads, or zero to use one per hardware thread
+  size_t workers = 0;
+  // give up on configurations that take longer than this, or zero for no deadline
+  std::chrono::nanoseconds deadline = std::chrono::nanoseconds(0);
+  // give up on configurations that take longer than the fastest one finished so far
+  bool prune = false;
+  // the scheduler policy of every configuration (see simsync::make_scheduler_policy), or empty for each one's own
+  std::string scheduler;
+  // the frequency governor of every configuration, with default options (see simsync::make_frequency_governor), or
+  // empty for each one's own
+  std::string governor;
+  // the instructions to warm up a core a thread did not last run on in every configuration (see
+  // simsync::system::set_migration_penalty), or negative for each one's own
+  int64_t migration_penalty = -1;
+  // the time slice and context switch cost of every configuration (see simsync::system::set_preemption), or negative
+  // for each one's own
+  std::chrono::nanoseconds timeslice = std::chrono::nanoseconds(-1);
+  std::chrono::nanoseconds context_switch = std::chrono::nanoseconds(-1);
+};
+
+/**
+ * Simulate how an simsync::application would run on each of several architecture configurations.
+ *
+ * The application is parsed once and shared by all simulations. Each configuration is loaded into its own
+ * simsync::architecture and simsync::system, and simulated with simsync::estimate on a pool of worker threads. When
+ * pruning, which configurations are given up on depends on the order they finish in, but the fastest configuration
+ * always completes.
+ *
+ * @param app The application to run.
+ * @param configs The architecture configuration files to simulate.
+ * @param options How to run the sweep.
+ *
+ * @return The estimate for each configuration, in the same order as configs.
+ */
+std::vector<sweep_result> sweep(
+    application const &app, std::vector<std::string> const &configs, sweep_options const &options);
+}
+
+#endif //SIMSYNC_SWEEP_HPP
@@ -6,9 +6,11 @@
 namespace simsync {
 class barrier_wait : public event {
 public:
-  explicit barrier_wait(int32_t thread_id, thread_model &tm, uint64_t barrier_address);
+  explicit barrier_wait(int32_t thread_id, uint64_t barrier_address);
 
-  transition synchronize() override;
+  transition synchronize(thread_model &tm) const override;
+
+  uint64_t get_object() const override;
 
 private:
   uint64_t const m_barrier_address;
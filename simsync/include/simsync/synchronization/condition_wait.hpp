@@ -6,9 +6,11 @@
 namespace simsync {
 class condition_wait : public event {
 public:
-  explicit condition_wait(int32_t thread_id, thread_model &tm, uint64_t condition_address);
+  explicit condition_wait(int32_t thread_id, uint64_t condition_address);
 
-  transition synchronize() override;
+  transition synchronize(thread_model &tm) const override;
+
+  uint64_t get_object() const override;
 
 private:
   void print(std::ostream &stream) const override;
@@ -8,8 +8,27 @@ namespace simsync {
 class thread_model;
 class transition;
 
+/**
+ * The kinds of synchronization event.
+ */
+enum class event_type {
+  thread_create,
+  thread_start,
+  thread_join,
+  thread_finish,
+  lock_acquire,
+  lock_release,
+  barrier_wait,
+  condition_wait,
+  condition_signal,
+  condition_broadcast
+};
+
 /**
  * A synchronization event.
+ *
+ * Events are immutable and do not own any synchronization state, so an application can be simulated many times, or
+ * by many simulations at once, each with its own simsync::thread_model.
  */
 class event {
 public:
@@ -17,8 +36,9 @@ public:
    * Construct a synchronization event.
    *
    * @param thread_id The thread this event belongs to.
+   * @param type The kind of event.
    */
-  explicit event(int32_t thread_id, thread_model &tm);
+  explicit event(int32_t thread_id, event_type type);
 
   /**
    * Destructor.
@@ -32,7 +52,7 @@ public:
    *
    * @return The resulting thread transitions based on the event and the thread model's state.
    */
-  virtual transition synchronize() = 0;
+  virtual transition synchronize(thread_model &tm) const = 0;
 
   /**
    * @return Get the thread ID that this event belongs to.
@@ -42,6 +62,23 @@ public:
     return m_thread_id;
   }
 
+  /**
+   * @return The kind of event.
+   */
+  event_type get_type() const
+  {
+    return m_type;
+  }
+
+  /**
+   * @return The synchronization object this event operates on: the address of a lock, barrier or condition variable,
+   * or the ID of the thread being created or joined. Zero for events without an object.
+   */
+  virtual uint64_t get_object() const
+  {
+    return 0;
+  }
+
   /**
    * Output the synchronization event to the stream.
    *
@@ -59,7 +96,7 @@ public:
 protected:
   int32_t const m_thread_id;
 
-  thread_model &m_thread_model;
+  event_type const m_type;
 
   virtual void print(std::ostream &stream) const = 0;
 };
@@ -6,9 +6,11 @@
 namespace simsync {
 class lock_acquire : public event {
 public:
-  explicit lock_acquire(int32_t thread_id, thread_model &tm, uint64_t lock_address);
+  explicit lock_acquire(int32_t thread_id, uint64_t lock_address);
 
-  transition synchronize() override;
+  transition synchronize(thread_model &tm) const override;
+
+  uint64_t get_object() const override;
 
 private:
   uint64_t const m_lock_address;
@@ -16,9 +16,11 @@ public:
    * @param parent_id The current thread performing the event.
    * @param future_id The ID of the thread that will be created.
    */
-  explicit thread_create(int32_t parent_id, thread_model &tm, int32_t future_id);
+  explicit thread_create(int32_t parent_id, int32_t future_id);
 
-  transition synchronize() override;
+  transition synchronize(thread_model &tm) const override;
+
+  uint64_t get_object() const override;
 
 private:
   int32_t const m_future_thread_id;
@@ -15,9 +15,9 @@ public:
    *
    * @param thread_id The thread that has finished.
    */
-  explicit thread_finish(int32_t thread_id, thread_model &tm);
+  explicit thread_finish(int32_t thread_id);
 
-  transition synchronize() override;
+  transition synchronize(thread_model &tm) const override;
 
 private:
   void print(std::ostream &stream) const override;
@@ -16,9 +16,11 @@ public:
    * @param thread_id The thread that wants to wait.
    * @param target_thread The thread to be waited for.
    */
-  explicit thread_join(int32_t thread_id, thread_model &tm, int32_t target_thread);
+  explicit thread_join(int32_t thread_id, int32_t target_thread);
 
-  transition synchronize() override;
+  transition synchronize(thread_model &tm) const override;
+
+  uint64_t get_object() const override;
 
 private:
   int32_t const m_target_thread;
@@ -4,6 +4,7 @@
 #include <simsync/synchronization/transition.hpp>
 
 #include <cstdint>
+#include <cstddef>
 #include <deque>
 #include <map>
 #include <set>
@@ -25,6 +26,51 @@ public:
    */
   void add_barrier(uint64_t barrier_address, size_t count);
 
+  /**
+   * @return The number of threads that must wait at each barrier, indexable by barrier address.
+   */
+  std::map<uint64_t, size_t> const &barriers() const
+  {
+    return m_barriers;
+  }
+
+  /**
+   * Make a lock contention-free, as if it were elided.
+   *
+   * Acquiring the lock never waits, and releasing it never wakes a thread. Threads still hold the lock for the
+   * purpose of waiting on condition variables.
+   *
+   * @param lock_address The address the lock is located at.
+   */
+  void elide_lock(uint64_t lock_address)
+  {
+    m_elided_locks.insert(lock_address);
+  }
+
+  /**
+   * Simulate contention on a lock that was elided again. No thread may hold the lock.
+   *
+   * @param lock_address The address the lock is located at.
+   */
+  void restore_lock(uint64_t lock_address)
+  {
+    m_elided_locks.erase(lock_address);
+  }
+
+  /**
+   * @param lock_address The address a lock is located at.
+   *
+   * @return true if a thread holds the lock, or waits for it, unless the lock is elided.
+   */
+  bool is_locked(uint64_t lock_address) const;
+
+  /**
+   * @param thread_id The thread.
+   *
+   * @return true if the thread holds a lock that other threads are waiting for.
+   */
+  bool holds_contended_lock(int32_t thread_id) const;
+
   void approximate_broadcast(int32_t thread_id, uint64_t condition_address);
 
   void approximate_signal(int32_t thread_id, uint64_t condition_address);
@@ -142,6 +188,8 @@ private:
   std::map<int32_t, std::deque<uint64_t>> m_silent_reacquire;
   // for each condition variable: approximation of production by producers
   std::map<uint64_t, size_t> m_production;
+  // locks that never block
+  std::set<uint64_t> m_elided_locks;
 
   void work(int32_t thread_id);
   void wait(int32_t thread_id);
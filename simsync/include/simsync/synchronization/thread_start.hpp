@@ -6,9 +6,9 @@
 namespace simsync {
 class thread_start : public event {
 public:
-  explicit thread_start(int32_t thread_id, thread_model &tm);
+  explicit thread_start(int32_t thread_id);
 
-  transition synchronize() override;
+  transition synchronize(thread_model &tm) const override;
 
 private:
   void print(std::ostream &stream) const override;
@@ -1,14 +1,50 @@
 #ifndef SIMSYNC_SYSTEM_HPP
 #define SIMSYNC_SYSTEM_HPP
 
+#include <simsync/frequency_governor.hpp>
+#include <simsync/scheduler_policy.hpp>
+#include <simsync/timing.hpp>
+
 #include <cstdint>
+#include <cstddef>
 #include <deque>
 #include <map>
+#include <memory>
 #include <set>
+#include <string>
+#include <vector>
 
 namespace simsync {
 class architecture;
 class core;
+class thread_model;
+
+/**
+ * A thread starting or stopping execution on a core.
+ */
+struct schedule_change {
+  int32_t thread_id;
+  size_t core_id;
+  bool executing;
+  // the change was made by a time slice running out: the thread was preempted part-way through a computation, or took
+  // the core of a preempted thread
+  bool switched = false;
+  // the thread kept executing, but its core changed frequency, or its CPI changed as sibling cores started or
+  // stopped
+  bool rescaled = false;
+  // the thread started executing on a different core than it last ran on
+  bool migrated = false;
+};
+
+/**
+ * The energy used by cores and the threads executing on them, in joules.
+ */
+struct energy_totals {
+  // for each core, indexable by core
+  std::vector<double> cores;
+  // for each thread that has executed: the energy of the cores while it executed on them
+  std::map<int32_t, double> threads;
+};
 
 /**
  * An operating system model.
@@ -18,11 +54,218 @@ public:
   /**
    * Construct an operating system to manage an simsync::architecture.
    *
+   * The scheduler policy is named by the optional "scheduler" entry of the "system" configuration (see
+   * simsync::make_scheduler_policy), and is FIFO by default. Threads are preempted if the optional "timeslice" entry
+   * is a positive number of nanoseconds (see set_preemption), with the optional "context.switch" entry as the cost.
+   * The frequency governor is named by the optional "governor" entry (see simsync::make_frequency_governor), and is
+   * static by default. Its options are the optional "governor.window" entry in nanoseconds, and the "governor.up",
+   * "governor.down" and "governor.waiting" entries (see simsync::governor_options). The optional "affinity" entry lists
+   * the cores each thread may run on, as {"tid": thread, "cores": [core, ...]}, and a thread without an entry may run on
+   * any core. The optional "migration.penalty" entry is the number of instructions a thread executes to warm up a core
+   * it did not last run on.
+   *
    * @param config_file The configuration input, which is expected to be valid.
    * @param arch The architecture to manage.
    */
   explicit system(const std::string &config_file, architecture &arch);
 
+  /**
+   * Copy the state of an operating system to manage another architecture.
+   *
+   * @param other The operating system to copy.
+   * @param arch The architecture to manage, which should be a copy of the one managed by other.
+   */
+  system(system const &other, architecture &arch);
+
+  /**
+   * Take over which threads are executing, sleeping and waiting from another operating system.
+   *
+   * This system keeps its own configuration, so the cores of executing threads are scaled to this system's static
+   * frequencies, and its own scheduler policy, governor and time slice. The policy and governor take over what they
+   * can of the state the other system's built up (see simsync::scheduler_policy::restore and
+   * simsync::frequency_governor::restore). The energy the other system used so far is carried over, if both
+   * architectures have power parameters.
+   *
+   * @param other The operating system to take the scheduling state from, which must manage as many cores.
+   */
+  void restore(system const &other);
+
+  /**
+   * @return The architecture managed by this operating system.
+   */
+  architecture const &get_architecture() const
+  {
+    return m_architecture;
+  }
+
+  /**
+   * @return The policy that decides which cores threads run on.
+   */
+  scheduler_policy const &get_scheduler() const
+  {
+    return *m_scheduler;
+  }
+
+  /**
+   * Replace the scheduler policy. This should be done before any thread is scheduled.
+   *
+   * @param policy The new policy.
+   */
+  void set_scheduler(std::unique_ptr<scheduler_policy> policy);
+
+  /**
+   * Preempt threads that have used up their time slice while others wait for a core.
+   *
+   * A scheduler tick happens every time slice. At each tick, a thread that has had its core since the previous tick or
+   * longer is preempted in favour of a waiting thread, longest running first. The preempted thread waits for a core
+   * again, and the thread that takes its core pays the context switch cost before it continues. Ticks only happen
+   * while threads are waiting, so executing threads are never interrupted otherwise.
+   *
+   * @param timeslice The time between scheduler ticks, or zero for no preemption.
+   * @param context_switch The time to switch a core from a preempted thread to a waiting one.
+   */
+  void set_preemption(picoseconds timeslice, picoseconds context_switch);
+
+  /**
+   * @return The time between scheduler ticks, or zero if threads are not preempted.
+   */
+  picoseconds timeslice() const
+  {
+    return m_timeslice;
+  }
+
+  /**
+   * @return The time to switch a core from a preempted thread to a waiting one.
+   */
+  picoseconds context_switch() const
+  {
+    return m_context_switch;
+  }
+
+  /**
+   * @return The time of the next scheduler tick that will preempt a thread, or picoseconds::max() if there is none.
+   * This is updated by take_changes.
+   */
+  picoseconds next_preemption() const
+  {
+    return m_next_preemption;
+  }
+
+  /**
+   * Preempt the threads whose time slice has run out at a scheduler tick.
+   */
+  void preempt();
+
+  /**
+   * @return The number of instructions a thread executes to warm up a core it did not last run on.
+   */
+  int64_t migration_penalty() const
+  {
+    return m_migration_penalty;
+  }
+
+  /**
+   * @param instructions The number of instructions a thread executes to warm up a core it did not last run on.
+   */
+  void set_migration_penalty(int64_t instructions)
+  {
+    m_migration_penalty = instructions;
+  }
+
+  /**
+   * @return For each thread that has run: the core it last ran on.
+   */
+  std::map<int32_t, size_t> const &last_cores() const
+  {
+    return m_last_core;
+  }
+
+  /**
+   * @return For each thread that has migrated: the number of times it started executing on a different core than it
+   * last ran on.
+   */
+  std::map<int32_t, uint64_t> const &migrations() const
+  {
+    return m_migrations;
+  }
+
+  /**
+   * Get the energy used so far, if the architecture has power parameters.
+   *
+   * Each core draws the active power of its frequency level while a thread executes on it, and the idle power of its
+   * type otherwise. Sibling cores share one physical core, so its active power is split between the busy siblings,
+   * and its idle power is split between all siblings while none is busy. The energy is accumulated as threads start
+   * and stop and cores change frequency, so this only adds the time since each core last changed.
+   *
+   * @param until The present time.
+   * @return The energy, which has no cores if the architecture has no power parameters.
+   */
+  energy_totals energy(picoseconds until) const;
+
+  /**
+   * Check whether a thread may run on a core.
+   *
+   * A thread of an application scheduled alongside others that has no affinity of its own uses the affinity of the
+   * thread with the same local ID in the first application.
+   *
+   * @param thread_id The thread.
+   * @param core_id The core.
+   * @return true if the core is in the thread's affinity mask, or the thread has none.
+   */
+  bool is_allowed(int32_t thread_id, size_t core_id) const;
+
+  /**
+   * @return true if any thread has an affinity mask.
+   */
+  bool has_affinity() const
+  {
+    return !m_affinity.empty();
+  }
+
+  /**
+   * @return The governor that decides the frequency level of each core.
+   */
+  frequency_governor const &get_governor() const
+  {
+    return *m_governor;
+  }
+
+  /**
+   * Replace the frequency governor. Executing threads keep their frequency until the next call to govern.
+   *
+   * @param governor The new governor.
+   */
+  void set_governor(std::unique_ptr<frequency_governor> governor);
+
+  /**
+   * @return The next time the governor needs to be asked for levels even if no thread changes state, or
+   * picoseconds::max() if there is none.
+   */
+  picoseconds next_governor_update() const
+  {
+    return m_governor->next_update();
+  }
+
+  /**
+   * Scale the core of each executing thread to the level chosen by the governor. A thread whose core changes frequency
+   * is recorded as a rescaled change.
+   *
+   * @param tm The synchronization state of the threads.
+   */
+  void govern(thread_model const &tm);
+
+  /**
+   * Let the operating system observe the passing of time. This is called before each change to the threads.
+   *
+   * @param current_time The present time.
+   */
+  void update(picoseconds const current_time)
+  {
+    m_time = current_time;
+    m_scheduler->update(current_time, *this);
+    m_governor->update(current_time, *this);
+  }
+
   /**
    * @return The set of currently executing threads.
    */
@@ -57,6 +300,34 @@ public:
    */
   core const &get_thread_core(int32_t thread_id) const;
 
+  /**
+   * Get the index of the core the thread is running on.
+   *
+   * This is only valid for thread ids that are currently executing.
+   *
+   * @param thread_id An executing thread.
+   * @return the index of the core in the architecture.
+   */
+  size_t get_thread_core_id(int32_t thread_id) const;
+
+  /**
+   * Get the frequency level a thread runs its core at.
+   *
+   * A thread of an application scheduled alongside others that has no level of its own uses the level of the thread
+   * with the same local ID in the first application.
+   *
+   * @param thread_id The thread.
+   * @return the static frequency level of the thread, or zero if none was configured.
+   */
+  int32_t static_frequency(int32_t thread_id) const;
+
+  /**
+   * Take the changes to the set of executing threads since the last call, in the order they happened.
+   *
+   * @param[out] changes Replaced by the changes.
+   */
+  void take_changes(std::vector<schedule_change> *changes);
+
   /**
    * Schedule a thread to run on a core.
    *
@@ -110,11 +381,61 @@ private:
   // maps threads to a static frequency level
   std::map<int32_t, int32_t> m_static_frequencies;
 
+  // maps threads to the cores they may run on
+  std::map<int32_t, std::set<size_t>> m_affinity;
+
+  int64_t m_migration_penalty = 0;
+
+  // for each thread that has run: the core it last ran on
+  std::map<int32_t, size_t> m_last_core;
+
+  std::map<int32_t, uint64_t> m_migrations;
+
+  // for each core, if the architecture has power parameters: the thread executing on it or -1, and since when the
+  // core has been in that state at its frequency
+  struct core_activity {
+    int32_t thread_id;
+    picoseconds since;
+  };
+  std::vector<core_activity> m_activity;
+
+  energy_totals m_energy;
+
+  void account(size_t core_id);
+
+  double pending_energy(size_t core_id, picoseconds until) const;
+
+  // threads that started or stopped executing since the last call to take_changes
+  std::vector<schedule_change> m_changes;
+
+  std::unique_ptr<scheduler_policy> m_scheduler;
+
+  std::unique_ptr<frequency_governor> m_governor;
+
+  picoseconds m_timeslice = picoseconds(0);
+  picoseconds m_context_switch = picoseconds(0);
+
+  // the last time observed by update
+  picoseconds m_time = picoseconds(0);
+
+  // for each executing thread: when it was given its core
+  std::map<int32_t, picoseconds> m_slice_start;
+
+  picoseconds m_next_preemption = picoseconds::max();
+
+  void plan_preemption();
+
+  std::set<size_t> const *affinity(int32_t thread_id) const;
+
+  bool has_available_core(int32_t thread_id) const;
+
   void use_next_core(int32_t thread_id);
 
+  void update_siblings(size_t core_id, bool busy);
+
   void free_core(int32_t thread_id);
 
-  void schedule_waiting_thread();
+  bool schedule_waiting_thread();
 };
 }
 
@@ -11,6 +11,12 @@ namespace simsync {
 
 using event_ptr = std::unique_ptr<event>;
 
+/**
+ * Applications scheduled together have their thread IDs namespaced: thread t of the application at index a has the ID
+ * a * application_thread_stride + t.
+ */
+constexpr int32_t application_thread_stride = 1000000;
+
 /**
  * A thread model.
  *
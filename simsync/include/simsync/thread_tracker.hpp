@@ -0,0 +1,200 @@
+#ifndef SIMSYNC_THREAD_TRACKER_HPP
+#define SIMSYNC_THREAD_TRACKER_HPP
+
+#include <simsync/timing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace simsync {
+class core;
+class cpi_sampler;
+class thread;
+
+/**
+ * Tracks the progress of threads.
+ *
+ * The state of executing threads is laid out as arrays sorted by thread ID, so that finding the next thread to reach
+ * an event and progressing all threads are single passes over contiguous memory. On x86, these passes are vectorized
+ * with the widest instruction set the CPU supports.
+ */
+class thread_tracker {
+public:
+  /**
+   * Construct a tracker with all threads at their first computation.
+   *
+   * @param threads The threads to track, indexable by thread ID.
+   */
+  explicit thread_tracker(std::map<int32_t, thread> const &threads);
+
+  /**
+   * Get the interval a thread is presently at.
+   *
+   * @param thread_id The thread to query.
+   *
+   * @return The index of the thread's current computation and next event.
+   */
+  size_t current_index(int32_t thread_id) const;
+
+  /**
+   * @return The number of executing threads.
+   */
+  size_t executing() const
+  {
+    return m_ids.size();
+  }
+
+  /**
+   * Get the time an executing thread needs to reach its next event.
+   *
+   * @param thread_id An executing thread.
+   *
+   * @return The time remaining in the thread's current computation.
+   */
+  picoseconds time_remaining(int32_t thread_id) const;
+
+  /**
+   * Start tracking the execution of a thread that has been assigned a core.
+   *
+   * The thread starts from the beginning of its current computation, unless it was suspended part-way through it, in
+   * which case it finishes the work that was left at the speed of its new core.
+   *
+   * @param thread_id The thread that started executing.
+   * @param c The core the thread is executing on.
+   */
+  void start(int32_t thread_id, core const &c);
+
+  /**
+   * Stop tracking the execution of a thread that no longer has a core.
+   *
+   * @param thread_id The thread that stopped executing.
+   */
+  void stop(int32_t thread_id);
+
+  /**
+   * Stop tracking the execution of a thread that lost its core part-way through a computation, remembering the work
+   * that was left.
+   *
+   * @param thread_id The thread that was preempted.
+   */
+  void suspend(int32_t thread_id);
+
+  /**
+   * Determine the executing thread that will reach its next synchronization event first.
+   *
+   * Ties are broken in favour of the lowest thread ID.
+   *
+   * @param[out] elapsed_time The minimum time taken to reach the next event.
+   *
+   * @return The thread ID that will reach the next event first.
+   */
+  int32_t next_thread(picoseconds *elapsed_time) const;
+
+  /**
+   * Progress all executing threads forward in time.
+   *
+   * @param next_thread The thread that will reach its event next.
+   * @param time The time the next_thread will take to reach its event.
+   */
+  void progress(int32_t next_thread, picoseconds time);
+
+  /**
+   * Move a thread to the start of the computation at an index.
+   *
+   * @param thread_id The thread to move.
+   * @param index The index of the computation to start.
+   */
+  void seek(int32_t thread_id, size_t index);
+
+  /**
+   * Progress all executing threads forward in time, without any of them reaching an event.
+   *
+   * @param time The time that passed, which is at most the time remaining of every executing thread.
+   */
+  void elapse(picoseconds time);
+
+  /**
+   * Make an executing thread wait before it continues its current computation.
+   *
+   * The wait is in wall-clock time, so unlike the computation it does not change with the speed of the core.
+   *
+   * @param thread_id An executing thread.
+   * @param time The time to wait.
+   */
+  void delay(int32_t thread_id, picoseconds time);
+
+  /**
+   * Make an executing thread do extra work before it continues its current computation, e.g., to warm up its core.
+   *
+   * The work is done after any wait, and changes with the speed of the core like the computation does.
+   *
+   * @param thread_id An executing thread.
+   * @param time The time the work takes at the core's present speed.
+   */
+  void extend(int32_t thread_id, picoseconds time);
+
+  /**
+   * Update the time an executing thread needs to reach its next event after its core changed speed.
+   *
+   * The work left in the current computation is kept, and converted to time at the core's present CPI and frequency.
+   *
+   * @param thread_id An executing thread.
+   * @param c The core the thread is executing on.
+   */
+  void retime(int32_t thread_id, core const &c);
+
+  /**
+   * Sample the CPI of each computation instead of using the mean CPI of the thread on its core.
+   *
+   * Only threads started after this call are affected, so it should be called before any thread starts.
+   *
+   * @param sampler The sampler, which must outlive the tracker, or nullptr to use the mean CPI.
+   */
+  void sample_cpi(cpi_sampler const *sampler)
+  {
+    m_sampler = sampler;
+  }
+
+private:
+  std::map<int32_t, thread> const &m_threads;
+  // for each thread, track the interval index we are presently at
+  std::map<int32_t, size_t> m_current_index;
+
+  // executing threads, sorted by ID, and for each one:
+  std::vector<int32_t> m_ids;
+  // the time until it reaches its next event
+  std::vector<int64_t> m_time;
+  // the part of that time spent computing, which is all of it once any wait the thread was delayed by is over
+  std::vector<int64_t> m_computation;
+  // the CPI of the thread on its core
+  std::vector<fixed_cpi> m_cpi;
+  // the standard deviation of that CPI
+  std::vector<fixed_cpi> m_cpi_stddev;
+  // the frequency of its core
+  std::vector<int64_t> m_frequency;
+
+  // for each suspended thread: the time it still needed to compute and to wait, and the speed it computed at
+  struct suspension {
+    int64_t time;
+    int64_t wait;
+    fixed_cpi cpi;
+    fixed_cpi cpi_stddev;
+    int64_t frequency;
+  };
+  std::map<int32_t, suspension> m_suspended;
+
+  cpi_sampler const *m_sampler = nullptr;
+
+  size_t slot(int32_t thread_id) const;
+
+  int64_t pending_wait(size_t slot) const;
+
+  fixed_cpi current_cpi(int32_t thread_id, fixed_cpi cpi, fixed_cpi cpi_stddev) const;
+
+  int64_t computation_time(int32_t thread_id, size_t slot) const;
+};
+}
+
+#endif //SIMSYNC_THREAD_TRACKER_HPP
@@ -0,0 +1,76 @@
+#ifndef SIMSYNC_TIMING_HPP
+#define SIMSYNC_TIMING_HPP
+
+#include <chrono>
+#include <cstdint>
+
+namespace simsync {
+
+/**
+ * The integer time base of the estimator.
+ *
+ * One picosecond at a frequency of one hertz is exactly 1e-12 cycles, so the product of a time and a frequency is
+ * an exact amount of work. All timing arithmetic is done on integers to keep estimates bit-reproducible.
+ */
+using picoseconds = std::chrono::duration<int64_t, std::pico>;
+
+/**
+ * Cycles-per-instruction in fixed point, counted in millionths of a cycle.
+ */
+using fixed_cpi = uint64_t;
+
+/**
+ * The number of fixed_cpi units in one cycle.
+ */
+constexpr uint64_t cpi_scale = 1000000;
+
+/**
+ * Convert a CPI rate from a configuration file into fixed point.
+ *
+ * @param cpi_rate The cycles-per-instruction.
+ *
+ * @return The CPI rounded to the nearest millionth of a cycle.
+ */
+fixed_cpi to_fixed_cpi(double cpi_rate);
+
+/**
+ * Estimate the time needed to execute instructions.
+ *
+ * @param instructions The number of instructions to execute.
+ * @param progress Work already done towards the first instruction, in hertz-picoseconds.
+ * @param cpi The cycles-per-instruction of the thread on its core.
+ * @param frequency The frequency of the core in hertz.
+ *
+ * @return The time to execute the instructions, rounded up to the next picosecond.
+ */
+picoseconds estimate_time(uint64_t instructions, uint64_t progress, fixed_cpi cpi, int64_t frequency);
+
+/**
+ * Estimate the number of instructions executed in an amount of time.
+ *
+ * @param time The time spent executing.
+ * @param cpi The cycles-per-instruction of the thread on its core.
+ * @param frequency The frequency of the core in hertz.
+ * @param[in,out] progress Work already done towards the next instruction, in hertz-picoseconds. Updated with the work
+ * left over after the returned number of instructions have completed.
+ *
+ * @return The number of instructions completed.
+ */
+uint64_t estimate_instructions(picoseconds time, fixed_cpi cpi, int64_t frequency, uint64_t *progress);
+
+/**
+ * Estimate the time needed to finish a computation after its CPI or frequency changes.
+ *
+ * @param remaining The time the computation still needed at the old CPI and frequency.
+ * @param old_cpi The cycles-per-instruction the remaining time was estimated with.
+ * @param old_frequency The frequency in hertz the remaining time was estimated with.
+ * @param cpi The new cycles-per-instruction.
+ * @param frequency The new frequency in hertz.
+ *
+ * @return The time to finish the same work, rounded up to the next picosecond.
+ */
+picoseconds rescale_time(
+    picoseconds remaining, fixed_cpi old_cpi, int64_t old_frequency, fixed_cpi cpi, int64_t frequency);
+}
+
+#endif //SIMSYNC_TIMING_HPP
@@ -62,7 +62,26 @@ struct trace_row {
   }
 };
 
-event_ptr create_event(thread_model &tm, trace_row const &row)
+// associates pthread_t handles with thread IDs while reading a trace
+struct handle_table {
+  std::map<pthread_t, int32_t> handles;
+  int32_t next_create_id = 0;
+};
+
+/**
+ * Move a row of a trace into the namespace of an application.
+ *
+ * @param row The row, as read from the trace.
+ * @param application_id The index of the application the trace belongs to.
+ */
+void namespace_row(trace_row &row, size_t const application_id)
+{
+  row.thread_id += static_cast<int32_t>(application_id) * application_thread_stride;
+  // user space addresses leave the top byte free
+  row.object |= static_cast<uint64_t>(application_id) << 56;
+}
+
+event_ptr create_event(thread_model &tm, handle_table &table, trace_row const &row)
 {
   static std::set<std::string> lock_calls = {
       "pthread_mutex_lock", "pthread_mutex_timedlock", "pthread_mutex_trylock",
@@ -75,14 +94,14 @@ event_ptr create_event(thread_model &tm, trace_row const &row)
       "pthread_mutex_unlock", "pthread_rwlock_unlock", "pthread_spin_unlock",
   };
 
-  static std::map<pthread_t, int32_t> handles;
+  auto &handles = table.handles;
 
   if(lock_calls.find(row.call) != lock_calls.end()) {
-    return std::make_unique<lock_acquire>(row.thread_id, tm, row.object);
+    return std::make_unique<lock_acquire>(row.thread_id, row.object);
   }
 
   if(unlock_calls.find(row.call) != unlock_calls.end()) {
-    return std::make_unique<lock_release>(row.thread_id, tm, row.object);
+    return std::make_unique<lock_release>(row.thread_id, row.object);
   }
 
   if(row.call == "pthread_barrier_init") {
@@ -91,7 +110,7 @@ event_ptr create_event(thread_model &tm, trace_row const &row)
   }
 
   if(row.call == "pthread_barrier_wait") {
-    return std::make_unique<barrier_wait>(row.thread_id, tm, row.object);
+    return std::make_unique<barrier_wait>(row.thread_id, row.object);
   }
 
   if(row.call == "pthread_cond_init") {
@@ -100,23 +119,22 @@ event_ptr create_event(thread_model &tm, trace_row const &row)
 
   if(row.call == "pthread_cond_broadcast") {
     tm.approximate_broadcast(row.thread_id, row.object);
-    return std::make_unique<condition_broadcast>(row.thread_id, tm, row.object);
+    return std::make_unique<condition_broadcast>(row.thread_id, row.object);
   }
 
   if(row.call == "pthread_cond_signal") {
     tm.approximate_signal(row.thread_id, row.object);
-    return std::make_unique<condition_signal>(row.thread_id, tm, row.object);
+    return std::make_unique<condition_signal>(row.thread_id, row.object);
   }
 
   if(row.call == "pthread_cond_wait") {
     tm.approximate_wait(row.thread_id, row.object);
-    return std::make_unique<condition_wait>(row.thread_id, tm, row.object);
+    return std::make_unique<condition_wait>(row.thread_id, row.object);
   }
 
   if(row.call == "pthread_create") {
     // we need to associate pthread_t handles with thread IDs
-    static int32_t next_create_id = 0;
-    next_create_id++;
+    auto const next_create_id = ++table.next_create_id;
 
     bool was_inserted = false;
     std::map<pthread_t, int32_t>::iterator handle;
@@ -128,21 +146,21 @@ event_ptr create_event(thread_model &tm, trace_row const &row)
       handle->second = next_create_id;
     }
 
-    return std::make_unique<thread_create>(row.thread_id, tm, next_create_id);
+    return std::make_unique<thread_create>(row.thread_id, next_create_id);
   }
 
   if(row.call == "pthread_join") {
     auto const &find_join_target = handles.find(row.handle);
 
-    return std::make_unique<thread_join>(row.thread_id, tm, find_join_target->second);
+    return std::make_unique<thread_join>(row.thread_id, find_join_target->second);
   }
 
   if(row.call == "thread_start") {
-    return std::make_unique<thread_start>(row.thread_id, tm);
+    return std::make_unique<thread_start>(row.thread_id);
   }
 
   if(row.call == "thread_finish") {
-    return std::make_unique<thread_finish>(row.thread_id, tm);
+    return std::make_unique<thread_finish>(row.thread_id);
   }
 
   return nullptr;
@@ -159,7 +177,27 @@ uint64_t create_work(std::deque<uint64_t> &thread_instructions)
 
 application::application(std::istream &trace)
 {
+  parse(trace);
+
+  m_thread_model.classify_condition_variables();
+}
+
+application::application(std::vector<std::istream *> const &traces)
+{
+  for(auto const trace : traces) {
+    parse(*trace);
+  }
+
+  m_thread_model.classify_condition_variables();
+}
+
+void application::parse(std::istream &trace)
+{
+  auto const application_id = m_applications++;
+
   std::map<int32_t, std::deque<uint64_t>> icounts;
+  handle_table handles;
+  handles.next_create_id = static_cast<int32_t>(application_id) * application_thread_stride;
   std::string line;
 
   // read up to the first empty line (i.e., not EOF)
@@ -168,10 +206,12 @@ application::application(std::istream &trace)
     trace_row row;
 
     if(line_stream >> row) {
+      namespace_row(row, application_id);
+
       auto thread_it = find_or_emplace(m_threads, row.thread_id, thread(row.thread_id));
       auto instructions_it = find_or_emplace(icounts, row.thread_id, std::deque<uint64_t>{});
 
-      auto e = create_event(m_thread_model, row);
+      auto e = create_event(m_thread_model, handles, row);
       if(e != nullptr) {
         instructions_it->second.push_back(row.instruction_count);
 
@@ -184,8 +224,16 @@ application::application(std::istream &trace)
       }
     }
   }
+}
 
-  m_thread_model.classify_condition_variables();
+std::map<int32_t, size_t> application::masters() const
+{
+  std::map<int32_t, size_t> masters;
+  for(size_t index = 0; index < m_applications; ++index) {
+    masters.emplace(static_cast<int32_t>(index) * application_thread_stride, 0);
+  }
+
+  return masters;
 }
 
 thread const &application::at(int32_t thread_id) const
@@ -202,4 +250,9 @@ std::map<int32_t, thread> const &application::threads() const
 {
   return m_threads;
 }
+
+thread_model const &application::get_thread_model() const
+{
+  return m_thread_model;
+}
 }
@@ -1,13 +1,18 @@
 #include "simsync/architecture.hpp"
 
+#include <algorithm>
 #include <fstream>
+#include <iterator>
 #include <json.hpp>
+#include <set>
+#include <stdexcept>
 
 namespace simsync {
 architecture::architecture(const std::string &config_file)
 {
   auto stream = std::ifstream(config_file);
   auto input = nlohmann::json::parse(stream);
+  auto types = std::make_shared<std::map<int32_t, core_type>>();
 
   for(auto const &core_type_config : input["architecture"]["core.types"]) {
     core_type new_core_type;
@@ -17,20 +22,58 @@ architecture::architecture(const std::string &config_file)
       double const cpi_rate = thread["cpi.rate"];
 
       new_core_type.add_cpi_rate(thread_id, cpi_rate);
+
+      if(thread.count("cpi.stddev") > 0) {
+        double const cpi_stddev = thread["cpi.stddev"];
+        new_core_type.add_cpi_stddev(thread_id, cpi_stddev);
+      }
     }
 
     for(auto const &level: core_type_config["frequency.levels"]) {
       new_core_type.add_frequency(level["id"], level["frequency"]);
+      if(level.count("power") > 0) {
+        new_core_type.add_power(level["id"], level["power"]);
+        m_has_power = true;
+      }
+    }
+
+    if(core_type_config.count("idle.power") > 0) {
+      new_core_type.set_idle_power(core_type_config["idle.power"]);
+      m_has_power = true;
     }
 
     int32_t const core_type_id = core_type_config["id"];
-    m_types.emplace(core_type_id, std::move(new_core_type));
+    types->emplace(core_type_id, std::move(new_core_type));
   }
+  m_types = std::move(types);
+
+  m_core_types = input["architecture"]["cores"].get<std::deque<int32_t>>();
+  m_siblings.resize(m_core_types.size());
+
+  auto const siblings = input["architecture"].find("siblings");
+  if(siblings != input["architecture"].end()) {
+    auto const factor = input["architecture"].find("sibling.cpi.factor");
+    if(factor == input["architecture"].end()) {
+      throw std::runtime_error("Error: sibling groups need a sibling.cpi.factor.");
+    }
+    m_has_siblings = true;
+    m_sibling_factor = factor->get<double>();
+
+    std::set<size_t> listed;
+    for(auto const &group : *siblings) {
+      auto const cores = group.get<std::vector<size_t>>();
+      for(auto const index : cores) {
+        if(index >= m_siblings.size() || !listed.insert(index).second) {
+          throw std::runtime_error("Error: sibling groups must list existing cores at most once.");
+        }
 
-  std::deque<int32_t> cores = input["architecture"]["cores"];
-  for(auto const core_type_id : cores) {
-    m_cores.emplace_back(m_types.at(core_type_id));
+        std::copy_if(cores.begin(), cores.end(), std::back_inserter(m_siblings[index]),
+            [index](size_t const other) { return other != index; });
+      }
+    }
   }
+
+  create_cores();
 }
 
 size_t architecture::size() const
@@ -42,4 +85,40 @@ core &architecture::get_core(size_t const index)
 {
   return m_cores[index];
 }
+
+core const &architecture::get_core(size_t const index) const
+{
+  return m_cores[index];
+}
+
+bool architecture::is_homogeneous() const
+{
+  for(auto const &c : m_cores) {
+    if(&c.type() != &m_cores.front().type()) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void architecture::scale_cpi_rate(int32_t const thread_id, double const factor)
+{
+  auto types = std::make_shared<std::map<int32_t, core_type>>(*m_types);
+  for(auto &t : *types) {
+    t.second.scale_cpi_rate(thread_id, factor);
+  }
+  m_types = std::move(types);
+
+  create_cores();
+}
+
+void architecture::create_cores()
+{
+  m_cores.clear();
+  for(auto const core_type_id : m_core_types) {
+    m_cores.emplace_back(m_types->at(core_type_id));
+    m_cores.back().set_sibling_factor(m_sibling_factor);
+  }
+}
 }
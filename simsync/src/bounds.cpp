@@ -0,0 +1,145 @@
+#include "simsync/bounds.hpp"
+
+#include "simsync/application.hpp"
+#include "simsync/architecture.hpp"
+#include "simsync/core.hpp"
+#include "simsync/core_type.hpp"
+#include "simsync/phases.hpp"
+#include "simsync/system.hpp"
+#include "simsync/synchronization/event.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace simsync {
+
+bounds estimate_bounds(application const &app, system const &sys)
+{
+  auto const &arch = sys.get_architecture();
+
+  std::set<core_type const *> types;
+  for(size_t index = 0; index < arch.size(); ++index) {
+    types.insert(&arch.get_core(index).type());
+  }
+
+  // a dynamic governor may run a thread at any level of its core
+  auto const is_dynamic = sys.get_governor().is_dynamic();
+
+  // a thread runs slower for each busy sibling of its core
+  auto const &largest_group = std::max_element(
+      arch.siblings().begin(), arch.siblings().end(), [](std::vector<size_t> const &a, std::vector<size_t> const &b) {
+        return a.size() < b.size();
+      });
+  auto const busy_siblings = largest_group != arch.siblings().end() ? largest_group->size() : 0;
+  auto const sibling_scale = 1.0 + static_cast<double>(busy_siblings) * (arch.sibling_factor() - 1.0);
+
+  // time can pass without any thread computing while threads switch or migrate cores
+  auto const is_unbounded = sys.context_switch().count() > 0 || sys.migration_penalty() > 0;
+
+  picoseconds longest_thread(0);
+  picoseconds fastest_total(0);
+  picoseconds slowest_total(0);
+
+  for(auto const &t : app.threads()) {
+    uint64_t instructions = 0;
+    for(size_t index = 0; index < t.second.size(); ++index) {
+      instructions += t.second.get_computation(index);
+    }
+
+    auto fastest = picoseconds(std::numeric_limits<int64_t>::max());
+    auto slowest = picoseconds(0);
+    for(auto const type : types) {
+      auto const static_level = sys.static_frequency(t.first);
+      auto const fastest_frequency = type->get_frequency(is_dynamic ? type->fastest_level() : static_level);
+      auto const slowest_frequency = type->get_frequency(is_dynamic ? type->slowest_level() : static_level);
+
+      auto const cpi = type->get_cpi(t.first);
+      auto const shared_cpi = static_cast<fixed_cpi>(std::ceil(static_cast<double>(cpi) * sibling_scale));
+
+      fastest = std::min(fastest, estimate_time(instructions, 0, cpi, fastest_frequency));
+      slowest = std::max(slowest, estimate_time(instructions, 0, shared_cpi, slowest_frequency));
+    }
+
+    longest_thread = std::max(longest_thread, fastest);
+    fastest_total += fastest;
+    // each computation is rounded up to the next picosecond separately
+    slowest_total += slowest + picoseconds(t.second.size());
+  }
+
+  auto const shared = picoseconds(fastest_total.count() / static_cast<int64_t>(std::max<size_t>(arch.size(), 1)));
+
+  using std::chrono::duration_cast;
+  using std::chrono::nanoseconds;
+  return bounds{duration_cast<nanoseconds>(std::max(longest_thread, shared)),
+      is_unbounded ? nanoseconds::max() : duration_cast<nanoseconds>(slowest_total)};
+}
+
+std::chrono::nanoseconds estimate_analytic(application const &app, system const &sys)
+{
+  auto const &arch = sys.get_architecture();
+  auto const cores = static_cast<double>(std::max<size_t>(arch.size(), 1));
+  phases plan(app);
+
+  // for each phase: its longest thread, the sum of its threads, and the time each lock is held
+  std::vector<double> longest(plan.size(), 0.0);
+  std::vector<double> total(plan.size(), 0.0);
+  std::vector<std::map<uint64_t, double>> held(plan.size());
+
+  for(auto const &t : app.threads()) {
+    // the picoseconds per instruction, averaged over all cores
+    double rate = 0.0;
+    for(size_t index = 0; index < arch.size(); ++index) {
+      auto const &type = arch.get_core(index).type();
+      auto const frequency = type.get_frequency(sys.static_frequency(t.first));
+      rate += static_cast<double>(type.get_cpi(t.first)) / cpi_scale * 1e12 / static_cast<double>(frequency);
+    }
+    rate /= cores;
+
+    std::vector<uint64_t> locks;
+    for(size_t p = 0; p < plan.size(); ++p) {
+      auto const start = p == 0 ? 0 : plan.start(p).at(t.first);
+      auto const end = p + 1 < plan.size() ? plan.start(p + 1).at(t.first) : t.second.size();
+
+      double time = 0.0;
+      for(auto index = start; index < end; ++index) {
+        // each computation leads up to the event at the same index
+        auto const computation = static_cast<double>(t.second.get_computation(index)) * rate;
+        time += computation;
+        for(auto const lock : locks) {
+          held[p][lock] += computation;
+        }
+
+        auto const e = t.second.get_event(index);
+        if(e->get_type() == event_type::lock_acquire) {
+          locks.push_back(e->get_object());
+        } else if(e->get_type() == event_type::lock_release) {
+          auto const lock = std::find(locks.rbegin(), locks.rend(), e->get_object());
+          if(lock != locks.rend()) {
+            locks.erase(std::next(lock).base());
+          }
+        }
+      }
+
+      longest[p] = std::max(longest[p], time);
+      total[p] += time;
+    }
+  }
+
+  double execution_time = 0.0;
+  for(size_t p = 0; p < plan.size(); ++p) {
+    auto phase_time = std::max(longest[p], total[p] / cores);
+    for(auto const &lock : held[p]) {
+      phase_time = std::max(phase_time, lock.second);
+    }
+
+    execution_time += phase_time;
+  }
+
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(picoseconds(std::llround(execution_time)));
+}
+}
@@ -0,0 +1,33 @@
+#include "simsync/checkpoint.hpp"
+
+namespace simsync {
+
+checkpoint::checkpoint(picoseconds const time,
+    uint64_t const events,
+    thread_model const &tm,
+    thread_tracker const &threads,
+    cpi_sampler const *sampler,
+    system const &sys,
+    std::deque<std::unique_ptr<report>> const &reports)
+    : m_time(time)
+    , m_events(events)
+    , m_thread_model(tm)
+    , m_threads(threads)
+    , m_sampler(sampler != nullptr ? std::make_unique<cpi_sampler>(*sampler) : nullptr)
+    , m_architecture(sys.get_architecture())
+    , m_system(sys, m_architecture)
+{
+  // the copied threads must not refer to the simulation's sampler, which may not outlive the checkpoint
+  m_threads.sample_cpi(m_sampler.get());
+
+  for(auto const &r : reports) {
+    // an empty part with the report's results merged in is a copy of the report
+    auto copy = r->split(m_system);
+    if(copy != nullptr) {
+      copy->merge(*r, picoseconds(0));
+    }
+
+    m_reports.push_back(std::move(copy));
+  }
+}
+}
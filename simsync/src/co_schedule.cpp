@@ -0,0 +1,56 @@
+#include "simsync/co_schedule.hpp"
+
+#include "simsync/application.hpp"
+#include "simsync/architecture.hpp"
+#include "simsync/parallel.hpp"
+#include "simsync/simulation.hpp"
+#include "simsync/system.hpp"
+#include "simsync/reports/completion_time.hpp"
+#include "simsync/reports/report_set.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace simsync {
+
+using std::chrono::nanoseconds;
+
+std::vector<co_schedule_result> co_schedule(application const &apps, system const &sys, size_t const workers)
+{
+  std::vector<co_schedule_result> results(apps.applications());
+  auto const masters = apps.masters();
+
+  // the first simulation runs every application, and each other runs one application alone
+  parallel_for(results.size() + 1, workers, [&](size_t const task) {
+    architecture arch(sys.get_architecture());
+    system task_sys(sys, arch);
+
+    if(task == 0) {
+      std::deque<std::unique_ptr<report>> reports;
+      reports.push_back(std::make_unique<completion_time>());
+
+      simulation sim(apps, task_sys, reports);
+      sim.run();
+
+      auto const &completion = static_cast<completion_time const &>(*reports.front());
+      for(auto const &c : completion.completion_times()) {
+        results.at(c.first).together = std::chrono::duration_cast<nanoseconds>(c.second);
+      }
+    } else {
+      auto const master = std::next(masters.begin(), static_cast<std::ptrdiff_t>(task - 1));
+
+      std::deque<std::unique_ptr<report>> const reports;
+      simulation sim(apps, task_sys, reports, {*master});
+
+      report_set<> no_reports;
+      results[task - 1].alone = sim.run(no_reports);
+    }
+  });
+
+  for(auto &r : results) {
+    r.slowdown = static_cast<double>(r.together.count()) / std::max<double>(static_cast<double>(r.alone.count()), 1.0);
+  }
+
+  return results;
+}
+}
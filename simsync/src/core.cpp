@@ -2,6 +2,8 @@
 
 #include "simsync/core_type.hpp"
 
+#include <cmath>
+
 namespace simsync {
 
 core::core(core_type const &type) : m_type(type), m_frequency(type.get_frequency(0))
@@ -11,10 +13,42 @@ core::core(core_type const &type) : m_type(type), m_frequency(type.get_frequency
 void core::scale_frequency(int32_t level)
 {
   m_frequency = m_type.get_frequency(level);
+  m_level = level;
 }
 
-double core::get_cpi(int32_t thread_id) const
+double core::active_power() const
 {
-  return m_type.get_cpi(thread_id);
+  return m_type.get_power(m_level);
+}
+
+void core::set_sibling_factor(double const factor)
+{
+  m_sibling_factor = factor;
+  set_busy_siblings(m_busy_siblings);
+}
+
+void core::set_busy_siblings(size_t const count)
+{
+  m_busy_siblings = count;
+  m_cpi_scale = 1.0 + static_cast<double>(count) * (m_sibling_factor - 1.0);
+}
+
+fixed_cpi core::get_cpi(int32_t thread_id) const
+{
+  return scale_cpi(m_type.get_cpi(thread_id));
+}
+
+fixed_cpi core::get_cpi_stddev(int32_t thread_id) const
+{
+  return scale_cpi(m_type.get_cpi_stddev(thread_id));
+}
+
+fixed_cpi core::scale_cpi(fixed_cpi const cpi) const
+{
+  if(m_busy_siblings == 0) {
+    return cpi;
+  }
+
+  return static_cast<fixed_cpi>(std::llround(static_cast<double>(cpi) * m_cpi_scale));
 }
 }
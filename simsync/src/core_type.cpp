@@ -1,32 +1,133 @@
 #include "simsync/core_type.hpp"
 
+#include "simsync/thread.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
 namespace simsync {
 void core_type::add_cpi_rate(int32_t const thread_id, double cpi_rate)
 {
-  auto emplaced = m_cpi_rates.emplace(thread_id, cpi_rate);
+  // a CPI that rounds to zero cycles would make every computation take no time
+  if(!(cpi_rate > 0.0) || to_fixed_cpi(cpi_rate) == 0) {
+    throw std::runtime_error("Error: CPI rates must be positive.");
+  }
+
+  auto emplaced = m_cpi_rates.emplace(thread_id, to_fixed_cpi(cpi_rate));
 
   if(!emplaced.second) {
     throw std::runtime_error("Error: attempting to overwrite CPI for thread.");
   }
 }
 
+void core_type::add_cpi_stddev(int32_t const thread_id, double const cpi_stddev)
+{
+  m_cpi_stddevs[thread_id] = to_fixed_cpi(cpi_stddev);
+}
+
+void core_type::scale_cpi_rate(int32_t const thread_id, double const factor)
+{
+  if(!(factor > 0.0)) {
+    throw std::runtime_error("Error: CPI rates must be scaled by a positive factor.");
+  }
+
+  auto const cpi_it = m_cpi_rates.find(thread_id);
+  if(cpi_it != m_cpi_rates.end()) {
+    auto const scaled = std::llround(static_cast<double>(cpi_it->second) * factor);
+    if(scaled <= 0) {
+      throw std::runtime_error("Error: CPI rates must be positive.");
+    }
+
+    cpi_it->second = static_cast<fixed_cpi>(scaled);
+  }
+}
+
 void core_type::add_frequency(int32_t level, int64_t frequency)
 {
   m_frequencies.emplace(level, frequency);
 }
 
-double core_type::get_cpi(int32_t thread_id) const
+fixed_cpi core_type::get_cpi(int32_t thread_id) const
 {
   auto const cpi_it = m_cpi_rates.find(thread_id);
   if(cpi_it != m_cpi_rates.end()) {
     return cpi_it->second;
   }
 
+  // threads of applications scheduled together default to the CPI of the same thread in the first application
+  if(thread_id >= application_thread_stride) {
+    return get_cpi(thread_id % application_thread_stride);
+  }
+
   throw std::runtime_error("Error: could not find CPI for thread.");
 }
 
+fixed_cpi core_type::get_cpi_stddev(int32_t const thread_id) const
+{
+  auto const stddev_it = m_cpi_stddevs.find(thread_id);
+  if(stddev_it != m_cpi_stddevs.end()) {
+    return stddev_it->second;
+  }
+
+  return thread_id >= application_thread_stride ? get_cpi_stddev(thread_id % application_thread_stride) : 0;
+}
+
+void core_type::add_power(int32_t const level, double const watts)
+{
+  m_power[level] = watts;
+}
+
+void core_type::set_idle_power(double const watts)
+{
+  m_idle_power = watts;
+}
+
 int64_t core_type::get_frequency(int32_t id) const
 {
   return m_frequencies.at(id);
 }
+
+double core_type::get_power(int32_t const id) const
+{
+  auto const power_it = m_power.find(id);
+
+  return power_it != m_power.end() ? power_it->second : 0.0;
+}
+
+int32_t core_type::fastest_level() const
+{
+  auto const fastest = std::max_element(m_frequencies.begin(), m_frequencies.end(),
+      [](std::pair<int32_t const, int64_t> const &a, std::pair<int32_t const, int64_t> const &b) {
+        return a.second < b.second;
+      });
+
+  return fastest->first;
+}
+
+int32_t core_type::slowest_level() const
+{
+  auto const slowest = std::min_element(m_frequencies.begin(), m_frequencies.end(),
+      [](std::pair<int32_t const, int64_t> const &a, std::pair<int32_t const, int64_t> const &b) {
+        return a.second < b.second;
+      });
+
+  return slowest->first;
+}
+
+int32_t core_type::slower_level(int32_t const id) const
+{
+  auto const frequency = get_frequency(id);
+
+  auto slower = id;
+  int64_t slower_frequency = 0;
+  for(auto const &f : m_frequencies) {
+    if(f.second < frequency && f.second > slower_frequency) {
+      slower = f.first;
+      slower_frequency = f.second;
+    }
+  }
+
+  return slower;
+}
 }
@@ -0,0 +1,40 @@
+#include "simsync/cpi_sampler.hpp"
+
+#include <cmath>
+
+namespace simsync {
+
+// the splitmix64 mixing function, which maps consecutive inputs to well distributed outputs
+inline uint64_t mix(uint64_t value)
+{
+  value += 0x9e3779b97f4a7c15;
+  value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9;
+  value = (value ^ (value >> 27)) * 0x94d049bb133111eb;
+
+  return value ^ (value >> 31);
+}
+
+// a uniform sample in (0, 1]
+inline double uniform(uint64_t const bits)
+{
+  return (static_cast<double>(bits >> 11) + 1.0) * (1.0 / 9007199254740992.0);
+}
+
+fixed_cpi cpi_sampler::sample(fixed_cpi const mean, fixed_cpi const stddev, int32_t const thread_id, size_t const index)
+    const
+{
+  if(stddev == 0) {
+    return mean;
+  }
+
+  auto const key = mix(m_seed ^ mix((static_cast<uint64_t>(static_cast<uint32_t>(thread_id)) << 40) ^ index));
+
+  // the Box-Muller transform
+  auto const pi = std::acos(-1.0);
+  auto const normal = std::sqrt(-2.0 * std::log(uniform(key))) * std::cos(2.0 * pi * uniform(mix(key)));
+
+  auto const cpi = static_cast<double>(mean) + normal * static_cast<double>(stddev);
+
+  return cpi < 1.0 ? 1 : static_cast<fixed_cpi>(std::llround(cpi));
+}
+}
@@ -0,0 +1,41 @@
+#include "simsync/criticality_accumulator.hpp"
+
+#include "simsync/system.hpp"
+
+namespace simsync {
+
+void criticality_accumulator::update(picoseconds const current_time, system const &sys)
+{
+  auto const delta_time = current_time - m_last_time;
+  m_last_time = current_time;
+
+  auto const total_waiting = sys.waiting_threads().size() + sys.sleeping_threads().size();
+  auto const total_running = sys.executing_threads().size();
+
+  // if only one thread is running, it should not impact their criticality
+  if(total_running > 1 && total_waiting > 0) {
+    auto const share = delta_time.count() / static_cast<int64_t>(total_waiting);
+    for(auto const &t : sys.executing_threads()) {
+      m_criticality[t] += share;
+      m_total += share;
+    }
+  }
+}
+
+void criticality_accumulator::merge(criticality_accumulator const &other, picoseconds const offset)
+{
+  for(auto const &criticality : other.m_criticality) {
+    m_criticality[criticality.first] += criticality.second;
+  }
+  m_total += other.m_total;
+
+  m_last_time = offset + other.m_last_time;
+}
+
+int64_t criticality_accumulator::criticality(int32_t const thread_id) const
+{
+  auto const it = m_criticality.find(thread_id);
+
+  return it != m_criticality.end() ? it->second : 0;
+}
+}
@@ -1,184 +1,306 @@
 #include "simsync/estimate.hpp"
 
 #include "simsync/application.hpp"
-#include "simsync/core.hpp"
-#include "simsync/reports/report.hpp"
+#include "simsync/architecture.hpp"
+#include "simsync/bounds.hpp"
+#include "simsync/checkpoint.hpp"
+#include "simsync/hot_locks.hpp"
+#include "simsync/parallel.hpp"
+#include "simsync/phases.hpp"
+#include "simsync/simulation.hpp"
 #include "simsync/system.hpp"
+#include "simsync/thread.hpp"
+#include "simsync/reports/criticality_stack.hpp"
+#include "simsync/reports/report.hpp"
+#include "simsync/reports/time_stack.hpp"
 
+#include <algorithm>
 #include <cmath>
 
 namespace simsync {
 
 using std::chrono::nanoseconds;
 
-nanoseconds estimate_time(uint64_t const instructions, double const cpi, int64_t const frequency)
+nanoseconds
+estimate(application const &app, system &sys, std::deque<std::unique_ptr<report>> const &reports)
+{
+  simulation sim(app, sys, reports);
+
+  return sim.run();
+}
+
+template <typename... Reports>
+nanoseconds estimate(application const &app, system &sys, report_set<Reports...> &reports)
+{
+  simulation sim(app, sys);
+
+  return sim.run(reports);
+}
+
+#define SIMSYNC_INSTANTIATE_ESTIMATE(...)                                                          \
+  template nanoseconds estimate(application const &, system &, report_set<__VA_ARGS__> &);
+SIMSYNC_FOR_EACH_REPORT_SET(SIMSYNC_INSTANTIATE_ESTIMATE)
+#undef SIMSYNC_INSTANTIATE_ESTIMATE
+
+nanoseconds estimate(application const &app,
+    system &sys,
+    std::deque<std::unique_ptr<report>> const &reports,
+    checkpoint_options const &options)
+{
+  simulation sim(app, sys, reports);
+  sim.take_checkpoints(options);
+
+  return sim.run();
+}
+
+nanoseconds estimate(application const &app,
+    system &sys,
+    std::deque<std::unique_ptr<report>> const &reports,
+    nanoseconds const deadline)
+{
+  // there is no need to simulate if the application cannot possibly finish in time
+  auto const lower_bound = estimate_bounds(app, sys).lower;
+  if(lower_bound > deadline) {
+    return lower_bound;
+  }
+
+  simulation sim(app, sys, reports);
+
+  // estimates are truncated to nanoseconds, so the deadline includes the whole nanosecond it ends in
+  auto const longest = std::chrono::duration_cast<nanoseconds>(picoseconds::max()) - nanoseconds(1);
+  if(deadline < longest && !sim.run_until(picoseconds(deadline + nanoseconds(1)) - picoseconds(1))) {
+    return deadline + nanoseconds(1);
+  }
+
+  return sim.run();
+}
+
+nanoseconds estimate(application const &app,
+    system &sys,
+    std::deque<std::unique_ptr<report>> const &reports,
+    hot_lock_options const &options)
 {
-  auto const cycles = instructions * cpi;
-  auto const period = 1 / static_cast<double>(frequency);
+  simulation sim(app, sys, reports);
+  sim.approximate_hot_locks(options);
+
+  auto const execution_time = sim.run();
+  if(options.summary != nullptr) {
+    *options.summary = sim.hot_locks();
+  }
 
-  return nanoseconds(static_cast<uint64_t>(std::ceil(1e9 * cycles * period)));
+  return execution_time;
 }
 
-uint64_t estimate_instructions(nanoseconds const time, double const cpi, int64_t const frequency)
+nanoseconds resume(application const &app,
+    checkpoint const &from,
+    system &sys,
+    std::deque<std::unique_ptr<report>> const &reports,
+    checkpoint_options const &options)
 {
-  return static_cast<uint64_t>((time.count() / cpi) * frequency * 1e-9);
+  simulation sim(app, from, sys, reports);
+  sim.take_checkpoints(options);
+
+  return sim.run();
 }
 
 /**
- * Tracks the progress of threads.
+ * A phase simulated on its own copy of the architecture and system.
  */
-class thread_tracker {
-public:
-  explicit thread_tracker(std::map<int32_t, thread> const &threads) : m_threads(threads)
+struct phase_simulation {
+  phase_simulation(system const &sys, std::deque<std::unique_ptr<report>> const &reports)
+      : arch(sys.get_architecture()), sys(sys, arch), duration(0)
   {
-    for(auto const &t : threads) {
-      m_instructions_remaining[t.first] = t.second.get_computation(0);
-      m_current_index[t.first] = 0;
+    for(auto const &r : reports) {
+      parts.push_back(r->split(this->sys));
     }
   }
 
-  uint64_t instructions_remaining(int32_t const thread_id) const
-  {
-    return m_instructions_remaining.at(thread_id);
-  }
+  architecture arch;
+  system sys;
+  std::deque<std::unique_ptr<report>> parts;
+  picoseconds duration;
+};
 
-  size_t current_index(int32_t const thread_id) const
-  {
-    return m_current_index.at(thread_id);
+nanoseconds estimate_phases(application const &app,
+    system &sys,
+    std::deque<std::unique_ptr<report>> const &reports,
+    phase_options const &options)
+{
+  phases plan(app);
+
+  // phases only start the same way regardless of history when threads need not wait for, or choose between, cores,
+  // do not remember the core they last ran on, do not slow each other down through shared physical cores, and run at
+  // levels that do not depend on a governor's measurements of earlier phases
+  auto const &arch = sys.get_architecture();
+  bool can_split = plan.size() > 1 && arch.is_homogeneous() && !arch.has_siblings() &&
+                   app.threads().size() <= arch.size() && sys.migration_penalty() == 0 && !sys.has_affinity() &&
+                   sys.next_governor_update() == picoseconds::max();
+  for(auto const &r : reports) {
+    can_split = can_split && r->split(sys) != nullptr;
   }
 
-  /**
-   * Progress a thread by a number of instructions.
-   *
-   * @param thread_id The thread to progress.
-   * @param instructions The number of instructions to progress by.
-   */
-  void progress(int32_t const thread_id, uint64_t const instructions)
-  {
-    auto &thread_instructions = m_instructions_remaining[thread_id];
+  if(!can_split) {
+    if(options.phases != nullptr && options.simulated != nullptr) {
+      *options.phases = *options.simulated = 1;
+    }
 
-    if(thread_instructions >= instructions) {
-      thread_instructions -= instructions;
-    } else {
-      // due to floating point, estimating instructions from time can cause some off-by-a-little errors
-      // so we ensure that thread_instructions remains non-negative
-      thread_instructions = 0;
+    return estimate(app, sys, reports);
+  }
+
+  // each phase is simulated only if it does not repeat an earlier one
+  std::vector<size_t> repeats(plan.size());
+  if(options.memoize) {
+    repeats = plan.find_repeats(app, options.tolerance);
+  } else {
+    for(size_t index = 0; index < plan.size(); ++index) {
+      repeats[index] = index;
     }
   }
 
-  /**
-   * Progress a thread to its next synchronization event.
-   *
-   * @param thread_id The thread to progress.
-   */
-  void next(int32_t const thread_id)
-  {
-    auto &index = m_current_index[thread_id];
+  std::vector<size_t> to_simulate;
+  for(size_t index = 0; index < plan.size(); ++index) {
+    if(repeats[index] == index) {
+      to_simulate.push_back(index);
+    }
+  }
 
-    // progress by one index
-    ++index;
-    // reset the instructions remaining to the new index
-    m_instructions_remaining[thread_id] = m_threads.at(thread_id).get_computation(index);
+  if(options.phases != nullptr && options.simulated != nullptr) {
+    *options.phases = plan.size();
+    *options.simulated = to_simulate.size();
   }
 
-private:
-  std::map<int32_t, thread> const &m_threads;
-  // for each thread, track the instructions remaining until the next event
-  std::map<int32_t, uint64_t> m_instructions_remaining;
-  // for each thread, track the interval index we are presently at
-  std::map<int32_t, size_t> m_current_index;
-};
+  std::vector<std::unique_ptr<phase_simulation>> simulations(plan.size());
+  parallel_for(to_simulate.size(), options.workers, [&](size_t const task) {
+    auto const index = to_simulate[task];
+    auto phase = std::make_unique<phase_simulation>(sys, reports);
+    // the first phase starts with the master threads
+    simulation sim(app, phase->sys, phase->parts, index == 0 ? app.masters() : plan.start(index));
 
-/**
- * Determine the thread that should progress to the next synchronization event.
- *
- * @param threads The current progress of the threads.
- * @param sys Information about the architecture
- * @param[out] elapsed_time The minimum time taken to reach the next event.
- *
- * @return The thread ID that will reach the next event first.
- */
-int32_t next_thread(thread_tracker const &threads, system const &sys, nanoseconds *elapsed_time)
-{
-  *elapsed_time = nanoseconds::max();
-  int32_t next_id = *sys.executing_threads().begin();
+    if(index + 1 < plan.size()) {
+      sim.run_until_release(plan.barrier(), plan.releases(index));
+    } else {
+      sim.run();
+    }
+    phase->duration = sim.time();
+
+    simulations[index] = std::move(phase);
+  });
 
-  for(auto const &t : sys.executing_threads()) {
-    auto const instructions = threads.instructions_remaining(t);
-    auto const &c = sys.get_thread_core(t);
+  picoseconds total_time = picoseconds(0);
+  for(size_t index = 0; index < plan.size(); ++index) {
+    // repeated phases replay the time and report results of the phase they repeat
+    auto const &phase = simulations[repeats[index]];
 
-    auto const thread_time = estimate_time(instructions, c.get_cpi(t), c.frequency());
-    if(thread_time < *elapsed_time) {
-      next_id = t;
-      *elapsed_time = thread_time;
+    for(size_t r = 0; r < reports.size(); ++r) {
+      reports[r]->merge(*phase->parts[r], total_time);
     }
+
+    total_time += phase->duration;
   }
 
-  return next_id;
+  return std::chrono::duration_cast<nanoseconds>(total_time);
 }
 
 /**
- * Progress all threads forward in time.
+ * Count the instructions executed in each phase.
+ *
+ * @param app The application.
+ * @param plan The phases of the application.
  *
- * @param next_thread The thread that will reach its event next.
- * @param time The time the next_thread will take to reach its event.
- * @param threads The current progress of all threads.
- * @param sys Information about the architecture.
+ * @return For each phase, the instructions executed by all threads.
  */
-void progress(int32_t const next_thread,
-    nanoseconds const time,
-    thread_tracker &threads,
-    system const &sys)
+std::vector<uint64_t> phase_instructions(application const &app, phases const &plan)
 {
-  auto executing_threads = sys.executing_threads();
-  executing_threads.erase(next_thread);
+  std::vector<uint64_t> instructions(plan.size(), 0);
 
-  for(auto const &t : executing_threads) {
-    auto const &c = sys.get_thread_core(t);
+  for(auto const &t : app.threads()) {
+    for(size_t index = 0; index < plan.size(); ++index) {
+      // the first phase starts at the beginning of every thread, and the last ends at the end of every thread
+      auto const start = index == 0 ? 0 : plan.start(index).at(t.first);
+      auto const end = index + 1 < plan.size() ? plan.start(index + 1).at(t.first) : t.second.size();
 
-    auto const instructions = estimate_instructions(time, c.get_cpi(t), c.frequency());
-    threads.progress(t, instructions);
+      for(auto computation = start; computation < end; ++computation) {
+        instructions[index] += t.second.get_computation(computation);
+      }
+    }
   }
 
-  threads.next(next_thread);
+  return instructions;
 }
 
-nanoseconds
-estimate(application const &app, system &sys, std::deque<std::unique_ptr<report>> const &reports)
+nanoseconds estimate_sampled(application const &app,
+    system &sys,
+    std::deque<std::unique_ptr<report>> const &reports,
+    sampling_options const &options)
 {
-  thread_tracker threads(app.threads());
+  phases plan(app);
+  auto const instructions = phase_instructions(app, plan);
 
-  // schedule master thread (assumed to have ID 0) for execution
-  sys.schedule(0);
+  if(options.phases != nullptr && options.simulated != nullptr) {
+    *options.phases = plan.size();
+    *options.simulated = plan.size();
+  }
+  if(options.error != nullptr) {
+    *options.error = nanoseconds(0);
+  }
 
-  nanoseconds total_time = nanoseconds(0);
-  while(!sys.executing_threads().empty()) {
-    nanoseconds elapsed_time = nanoseconds(0);
+  simulation sim(app, sys, reports);
 
-    // determine the next thread that will complete
-    auto const current_thread = next_thread(threads, sys, &elapsed_time);
-    auto const current_index = threads.current_index(current_thread);
-    auto current_event = app.at(current_thread).get_event(current_index);
+  // the picoseconds per instruction of each sampled phase
+  std::vector<double> rates;
+  auto phase_start = picoseconds(0);
+
+  for(size_t index = 0; index + 1 < plan.size(); ++index) {
+    if(sim.run_until_release(plan.barrier(), plan.releases(index))) {
+      break;
+    }
 
-    // progress time of all currently executing threads
-    progress(current_thread, elapsed_time, threads, sys);
-    total_time += elapsed_time;
+    auto const duration = sim.time() - phase_start;
+    phase_start = sim.time();
 
-    for(auto & report : reports) {
-      report->update(total_time, current_event);
+    if(index < options.warmup || instructions[index] == 0) {
+      continue;
     }
+    rates.push_back(static_cast<double>(duration.count()) / static_cast<double>(instructions[index]));
 
-    // update synchronization state
-    auto const state_changes = current_event->synchronize();
+    if(rates.size() < std::max<size_t>(options.samples, 2)) {
+      continue;
+    }
+
+    double sum = 0.0;
+    for(auto const rate : rates) {
+      sum += rate;
+    }
+    auto const mean = sum / static_cast<double>(rates.size());
 
-    // schedule threads based on synchronization state changes
-    sys.sleep(state_changes.to_sleep);
-    sys.schedule(state_changes.to_wake);
-    if(state_changes.finished != -1) {
-      sys.erase(state_changes.finished);
+    double squares = 0.0;
+    for(auto const rate : rates) {
+      squares += (rate - mean) * (rate - mean);
     }
+    auto const deviation = std::sqrt(squares / static_cast<double>(rates.size() - 1));
+    auto const margin = 1.96 * deviation / std::sqrt(static_cast<double>(rates.size()));
+
+    if(margin > options.confidence * mean) {
+      continue;
+    }
+
+    uint64_t remaining = 0;
+    for(auto later = index + 1; later < plan.size(); ++later) {
+      remaining += instructions[later];
+    }
+
+    if(options.phases != nullptr && options.simulated != nullptr) {
+      *options.simulated = index + 1;
+    }
+    if(options.error != nullptr) {
+      *options.error = nanoseconds(std::llround(margin * static_cast<double>(remaining) / 1000.0));
+    }
+
+    auto const extrapolated = picoseconds(std::llround(mean * static_cast<double>(remaining)));
+
+    return std::chrono::duration_cast<nanoseconds>(sim.time() + extrapolated);
   }
 
-  return total_time;
+  return sim.run();
 }
 }
@@ -0,0 +1,151 @@
+#include "simsync/frequency_governor.hpp"
+
+#include "simsync/architecture.hpp"
+#include "simsync/core.hpp"
+#include "simsync/core_type.hpp"
+#include "simsync/synchronization/thread_model.hpp"
+#include "simsync/system.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace simsync {
+
+std::unique_ptr<frequency_governor> static_governor::clone() const
+{
+  return std::make_unique<static_governor>(*this);
+}
+
+int32_t static_governor::level(int32_t const thread_id, size_t, system const &sys, thread_model const &) const
+{
+  return sys.static_frequency(thread_id);
+}
+
+std::unique_ptr<frequency_governor> lock_boost_governor::clone() const
+{
+  return std::make_unique<lock_boost_governor>(*this);
+}
+
+int32_t lock_boost_governor::level(
+    int32_t const thread_id, size_t const core_id, system const &sys, thread_model const &tm) const
+{
+  if(tm.holds_contended_lock(thread_id)) {
+    return sys.get_architecture().get_core(core_id).type().fastest_level();
+  }
+
+  return sys.static_frequency(thread_id);
+}
+
+contention_governor::contention_governor(double const waiting) : m_waiting(waiting)
+{
+}
+
+std::unique_ptr<frequency_governor> contention_governor::clone() const
+{
+  return std::make_unique<contention_governor>(*this);
+}
+
+int32_t contention_governor::level(
+    int32_t const thread_id, size_t const core_id, system const &sys, thread_model const &) const
+{
+  auto const waiting = sys.waiting_threads().size() + sys.sleeping_threads().size();
+  auto const threads = waiting + sys.executing_threads().size();
+
+  if(static_cast<double>(waiting) > m_waiting * static_cast<double>(threads)) {
+    return sys.get_architecture().get_core(core_id).type().slowest_level();
+  }
+
+  return sys.static_frequency(thread_id);
+}
+
+ondemand_governor::ondemand_governor(picoseconds const window, double const up, double const down)
+    : m_window(window), m_up(up), m_down(down), m_window_end(window)
+{
+  if(m_window.count() <= 0) {
+    throw std::runtime_error("Error: the ondemand governor needs a positive window.");
+  }
+}
+
+std::unique_ptr<frequency_governor> ondemand_governor::clone() const
+{
+  return std::make_unique<ondemand_governor>(*this);
+}
+
+int32_t ondemand_governor::level(int32_t, size_t const core_id, system const &sys, thread_model const &) const
+{
+  return core_level(core_id, sys);
+}
+
+int32_t ondemand_governor::core_level(size_t const core_id, system const &sys) const
+{
+  auto const it = m_levels.find(core_id);
+  if(it != m_levels.end()) {
+    return it->second;
+  }
+
+  return sys.get_architecture().get_core(core_id).type().fastest_level();
+}
+
+void ondemand_governor::update(picoseconds const current_time, system const &sys)
+{
+  // the executing threads have not changed since the last update, so cores were busy for all of the time between
+  while(m_last_time < current_time) {
+    auto const until = std::min(current_time, m_window_end);
+    for(auto const &t : sys.executing_threads()) {
+      m_busy[sys.get_thread_core_id(t)] += until - m_last_time;
+    }
+    m_last_time = until;
+
+    if(until < m_window_end) {
+      break;
+    }
+
+    for(size_t core_id = 0; core_id < sys.get_architecture().size(); ++core_id) {
+      auto const &type = sys.get_architecture().get_core(core_id).type();
+      auto const busy = m_busy[core_id];
+      auto const utilization = static_cast<double>(busy.count()) / static_cast<double>(m_window.count());
+
+      if(utilization > m_up) {
+        m_levels.erase(core_id);
+      } else if(utilization < m_down) {
+        m_levels[core_id] = type.slower_level(core_level(core_id, sys));
+      }
+    }
+
+    m_busy.clear();
+    m_window_end += m_window;
+  }
+}
+
+void ondemand_governor::restore(frequency_governor const &other, picoseconds const current_time)
+{
+  auto const ondemand = dynamic_cast<ondemand_governor const *>(&other);
+  if(ondemand != nullptr && ondemand->m_window == m_window) {
+    m_last_time = ondemand->m_last_time;
+    m_window_end = ondemand->m_window_end;
+    m_busy = ondemand->m_busy;
+    m_levels = ondemand->m_levels;
+    return;
+  }
+
+  m_last_time = current_time;
+  m_window_end = current_time + m_window;
+  m_busy.clear();
+  m_levels.clear();
+}
+
+std::unique_ptr<frequency_governor> make_frequency_governor(std::string const &name, governor_options const &options)
+{
+  if(name == "static") {
+    return std::make_unique<static_governor>();
+  } else if(name == "lock-boost") {
+    return std::make_unique<lock_boost_governor>();
+  } else if(name == "contention") {
+    return std::make_unique<contention_governor>(options.waiting);
+  } else if(name == "ondemand") {
+    return std::make_unique<ondemand_governor>(options.window, options.up, options.down);
+  }
+
+  throw std::runtime_error("Error: unknown frequency governor " + name + ".");
+}
+}
@@ -0,0 +1,224 @@
+#include "simsync/hot_locks.hpp"
+
+#include "simsync/application.hpp"
+#include "simsync/synchronization/event.hpp"
+#include "simsync/synchronization/thread_model.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <vector>
+
+namespace simsync {
+
+// picoseconds in a microsecond
+constexpr double picoseconds_per_microsecond = 1e6;
+
+/**
+ * Compute the squared coefficient of variation of a sample.
+ *
+ * @param count The number of values.
+ * @param sum The sum of the values.
+ * @param squares The sum of the squares of the values.
+ *
+ * @return The variance divided by the square of the mean.
+ */
+double squared_variation(uint64_t const count, double const sum, double const squares)
+{
+  auto const mean = sum / static_cast<double>(count);
+  auto const variance = std::max(squares / static_cast<double>(count) - mean * mean, 0.0);
+
+  return mean > 0.0 ? variance / (mean * mean) : 0.0;
+}
+
+hot_lock_model::hot_lock_model(application const &app, hot_lock_options const &options) : m_options(options)
+{
+  // a condition variable silently releases and re-acquires the innermost lock its waiter holds
+  for(auto const &t : app.threads()) {
+    std::vector<uint64_t> held;
+
+    for(size_t index = 0; index < t.second.size(); ++index) {
+      auto const e = t.second.get_event(index);
+
+      switch(e->get_type()) {
+      case event_type::lock_acquire:
+        held.push_back(e->get_object());
+        break;
+      case event_type::lock_release: {
+        auto const lock = std::find(held.rbegin(), held.rend(), e->get_object());
+        if(lock != held.rend()) {
+          held.erase(std::next(lock).base());
+        }
+        break;
+      }
+      case event_type::condition_wait:
+        if(!held.empty()) {
+          m_excluded.insert(held.back());
+        }
+        break;
+      default:
+        break;
+      }
+    }
+  }
+}
+
+picoseconds hot_lock_model::update(picoseconds const time, event const &e, thread_model &tm)
+{
+  auto const type = e.get_type();
+  if(type != event_type::lock_acquire && type != event_type::lock_release) {
+    return picoseconds(0);
+  }
+
+  auto const lock_address = e.get_object();
+  auto &state = m_locks[lock_address];
+
+  if(type == event_type::lock_acquire) {
+    if(state.has_arrived) {
+      auto const interarrival = static_cast<double>((time - state.last_arrival).count());
+      state.interarrival_sum += interarrival;
+      state.interarrival_squares += interarrival * interarrival;
+    }
+    state.has_arrived = true;
+    state.last_arrival = time;
+
+    if(++state.arrivals >= m_options.window) {
+      end_window(lock_address, state);
+    }
+
+    return acquire(time, e.get_thread_id(), state);
+  }
+
+  release(time, e.get_thread_id(), lock_address, state, tm);
+
+  return picoseconds(0);
+}
+
+hot_lock_summary hot_lock_model::summary(picoseconds const time) const
+{
+  hot_lock_summary total;
+
+  for(auto const &l : m_locks) {
+    auto const &state = l.second;
+
+    total.locks += state.was_approximated ? 1 : 0;
+    total.acquisitions += state.totals.acquisitions;
+    total.wait += state.totals.wait;
+    total.duration += state.totals.duration;
+    total.fallbacks += state.totals.fallbacks;
+
+    if(state.mode == lock_mode::approximate || state.mode == lock_mode::leaving) {
+      total.duration += time - state.approximated_since;
+    }
+  }
+
+  return total;
+}
+
+picoseconds hot_lock_model::acquire(picoseconds const time, int32_t const thread_id, lock_state &state)
+{
+  auto const is_approximated = state.mode == lock_mode::approximate || state.mode == lock_mode::leaving;
+  auto const wait = is_approximated ? state.wait : picoseconds(0);
+
+  state.holders[thread_id] = holder{time + wait, is_approximated};
+  if(is_approximated) {
+    ++state.approximated_holders;
+    ++state.totals.acquisitions;
+    state.totals.wait += wait;
+  }
+
+  return wait;
+}
+
+void hot_lock_model::release(picoseconds const time,
+    int32_t const thread_id,
+    uint64_t const lock_address,
+    lock_state &state,
+    thread_model &tm)
+{
+  auto const h = state.holders.find(thread_id);
+  if(h != state.holders.end()) {
+    picoseconds hold;
+    if(h->second.approximated) {
+      hold = time - h->second.time;
+      --state.approximated_holders;
+    } else {
+      // locks are handed over in order, so a thread that waited acquired the lock when the previous holder released it
+      hold = time - std::max(h->second.time, state.last_release);
+      state.last_release = time;
+    }
+    state.holders.erase(h);
+
+    auto const duration = static_cast<double>(hold.count());
+    ++state.holds;
+    state.hold_sum += duration;
+    state.hold_squares += duration * duration;
+  }
+
+  if(state.mode == lock_mode::entering && !tm.is_locked(lock_address)) {
+    tm.elide_lock(lock_address);
+    state.mode = lock_mode::approximate;
+    state.approximated_since = time;
+    state.was_approximated = true;
+  } else if(state.mode == lock_mode::leaving && state.approximated_holders == 0) {
+    tm.restore_lock(lock_address);
+    state.mode = lock_mode::exact;
+    state.totals.duration += time - state.approximated_since;
+    state.last_release = time;
+  }
+}
+
+void hot_lock_model::end_window(uint64_t const lock_address, lock_state &state)
+{
+  auto const intervals = state.arrivals - 1;
+  auto const holds = state.holds;
+  auto const interarrival_sum = state.interarrival_sum;
+  auto const interarrival_squares = state.interarrival_squares;
+  auto const hold_sum = state.hold_sum;
+  auto const hold_squares = state.hold_squares;
+
+  // the arrival that ends this window starts the next
+  state.arrivals = 1;
+  state.interarrival_sum = state.interarrival_squares = 0.0;
+  state.holds = 0;
+  state.hold_sum = state.hold_squares = 0.0;
+
+  if(state.mode == lock_mode::leaving) {
+    return;
+  }
+
+  bool is_hot = intervals > 1 && holds > 1 && interarrival_sum > 0.0 && m_excluded.count(lock_address) == 0;
+
+  auto const arrival_rate = is_hot ? static_cast<double>(intervals) / interarrival_sum : 0.0;
+  auto const hold_time = is_hot ? hold_sum / static_cast<double>(holds) : 0.0;
+  auto const utilization = arrival_rate * hold_time;
+  is_hot = is_hot && arrival_rate * picoseconds_per_microsecond >= m_options.rate &&
+           utilization < m_options.utilization;
+
+  if(state.mode == lock_mode::approximate) {
+    auto const has_changed = std::abs(arrival_rate - state.arrival_rate) > m_options.tolerance * state.arrival_rate ||
+                             std::abs(hold_time - state.hold_time) > m_options.tolerance * state.hold_time;
+
+    if(!is_hot || has_changed) {
+      state.mode = lock_mode::leaving;
+      ++state.totals.fallbacks;
+
+      return;
+    }
+  } else {
+    state.mode = is_hot ? lock_mode::entering : lock_mode::exact;
+    if(!is_hot) {
+      return;
+    }
+  }
+
+  // Kingman's approximation of the time spent waiting in a G/G/1 queue
+  auto const arrival_variation = squared_variation(intervals, interarrival_sum, interarrival_squares);
+  auto const hold_variation = squared_variation(holds, hold_sum, hold_squares);
+  auto const wait = utilization / (1.0 - utilization) * (arrival_variation + hold_variation) / 2.0 * hold_time;
+
+  state.arrival_rate = arrival_rate;
+  state.hold_time = hold_time;
+  state.wait = picoseconds(std::llround(wait));
+}
+}
@@ -0,0 +1,81 @@
+#include "simsync/lock_elision.hpp"
+
+#include "simsync/application.hpp"
+#include "simsync/architecture.hpp"
+#include "simsync/parallel.hpp"
+#include "simsync/simulation.hpp"
+#include "simsync/system.hpp"
+#include "simsync/reports/report.hpp"
+#include "simsync/reports/report_set.hpp"
+#include "simsync/synchronization/event.hpp"
+
+#include <algorithm>
+#include <map>
+
+namespace simsync {
+
+using std::chrono::nanoseconds;
+
+std::vector<lock_elision_result> estimate_lock_elision(application const &app,
+    system const &sys,
+    lock_elision_options const &options,
+    nanoseconds *baseline)
+{
+  std::map<uint64_t, size_t> acquisitions;
+  for(auto const &t : app.threads()) {
+    for(size_t index = 0; index < t.second.size(); ++index) {
+      auto const e = t.second.get_event(index);
+      if(e->get_type() == event_type::lock_acquire) {
+        ++acquisitions[e->get_object()];
+      }
+    }
+  }
+
+  std::vector<lock_elision_result> results;
+  for(auto const &a : acquisitions) {
+    results.push_back(lock_elision_result{a.first, a.second, nanoseconds(0), 1.0});
+  }
+
+  // the most acquired locks first, breaking ties by address
+  std::stable_sort(results.begin(), results.end(), [](lock_elision_result const &a, lock_elision_result const &b) {
+    return a.acquisitions > b.acquisitions;
+  });
+  if(options.top > 0 && options.top < results.size()) {
+    results.resize(options.top);
+  }
+
+  // the first simulation elides no lock
+  nanoseconds reference(0);
+  parallel_for(results.size() + 1, options.workers, [&](size_t const task) {
+    architecture arch(sys.get_architecture());
+    system task_sys(sys, arch);
+
+    simulation sim(app, task_sys);
+    if(task > 0) {
+      sim.elide_lock(results[task - 1].lock);
+    }
+
+    report_set<> no_reports;
+    auto const time = sim.run(no_reports);
+    if(task > 0) {
+      results[task - 1].execution_time = time;
+    } else {
+      reference = time;
+    }
+  });
+
+  for(auto &r : results) {
+    auto const time = std::max<double>(static_cast<double>(r.execution_time.count()), 1.0);
+    r.speedup = static_cast<double>(reference.count()) / time;
+  }
+
+  std::stable_sort(results.begin(), results.end(),
+      [](lock_elision_result const &a, lock_elision_result const &b) { return a.speedup > b.speedup; });
+
+  if(baseline != nullptr) {
+    *baseline = reference;
+  }
+
+  return results;
+}
+}
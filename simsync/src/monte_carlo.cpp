@@ -0,0 +1,76 @@
+#include "simsync/monte_carlo.hpp"
+
+#include "simsync/architecture.hpp"
+#include "simsync/parallel.hpp"
+#include "simsync/simulation.hpp"
+#include "simsync/system.hpp"
+#include "simsync/reports/report.hpp"
+#include "simsync/reports/report_set.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace simsync {
+
+using std::chrono::nanoseconds;
+
+monte_carlo_result estimate_replicates(application const &app, system const &sys, monte_carlo_options const &options)
+{
+  monte_carlo_result result{};
+  result.execution_times.resize(options.replicates);
+
+  parallel_for(options.replicates, options.workers, [&](size_t const replicate) {
+    // copies of the architecture share its core types
+    architecture arch(sys.get_architecture());
+    system replicate_sys(sys, arch);
+
+    simulation sim(app, replicate_sys);
+    sim.sample_cpi(options.seed + replicate);
+
+    report_set<> no_reports;
+    result.execution_times[replicate] = sim.run(no_reports);
+  });
+
+  if(options.replicates == 0) {
+    return result;
+  }
+
+  double sum = 0.0;
+  for(auto const time : result.execution_times) {
+    sum += static_cast<double>(time.count());
+  }
+  auto const mean = sum / static_cast<double>(options.replicates);
+
+  double squares = 0.0;
+  for(auto const time : result.execution_times) {
+    squares += (static_cast<double>(time.count()) - mean) * (static_cast<double>(time.count()) - mean);
+  }
+  auto const deviation =
+      options.replicates > 1 ? std::sqrt(squares / static_cast<double>(options.replicates - 1)) : 0.0;
+
+  // the normal approximation of the sampling distribution of the mean
+  auto const margin = 1.96 * deviation / std::sqrt(static_cast<double>(options.replicates));
+
+  result.mean = nanoseconds(std::llround(mean));
+  result.standard_deviation = nanoseconds(std::llround(deviation));
+  result.confidence_lower = nanoseconds(std::llround(mean - margin));
+  result.confidence_upper = nanoseconds(std::llround(mean + margin));
+
+  return result;
+}
+
+nanoseconds percentile(monte_carlo_result const &result, double const fraction)
+{
+  if(result.execution_times.empty()) {
+    throw std::runtime_error("Error: a percentile needs at least one replicate.");
+  }
+
+  auto sorted = result.execution_times;
+  std::sort(sorted.begin(), sorted.end());
+
+  auto const rank = static_cast<size_t>(std::ceil(std::max(0.0, std::min(1.0, fraction)) * sorted.size()));
+
+  return sorted[rank > 0 ? rank - 1 : 0];
+}
+}
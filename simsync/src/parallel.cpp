@@ -0,0 +1,55 @@
+#include "simsync/parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace simsync {
+
+void parallel_for(size_t const count, size_t workers, std::function<void(size_t)> const &task)
+{
+  if(workers == 0) {
+    workers = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  }
+  workers = std::min(workers, count);
+
+  std::atomic<size_t> next_index(0);
+  std::exception_ptr failure;
+  std::mutex failure_mutex;
+
+  auto const work = [&]() {
+    for(auto index = next_index++; index < count; index = next_index++) {
+      try {
+        task(index);
+      } catch(...) {
+        std::lock_guard<std::mutex> lock(failure_mutex);
+        if(!failure) {
+          failure = std::current_exception();
+        }
+
+        // skip the remaining tasks
+        next_index = count;
+      }
+    }
+  };
+
+  std::vector<std::thread> pool;
+  for(size_t i = 1; i < workers; ++i) {
+    pool.emplace_back(work);
+  }
+
+  // the calling thread is one of the workers
+  work();
+
+  for(auto &worker : pool) {
+    worker.join();
+  }
+
+  if(failure) {
+    std::rethrow_exception(failure);
+  }
+}
+}
@@ -0,0 +1,249 @@
+#include "simsync/phases.hpp"
+
+#include "simsync/application.hpp"
+
+#include <cmath>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace simsync {
+
+/**
+ * Find the barrier that every thread waits at the same number of times, preferring the one waited at most often.
+ *
+ * @param app The application to search.
+ * @param[out] barrier The address of the barrier.
+ * @param[out] waits The number of times each thread waits at the barrier.
+ *
+ * @return true if such a barrier was found.
+ */
+bool find_global_barrier(application const &app, uint64_t *barrier, size_t *waits)
+{
+  *waits = 0;
+
+  for(auto const &b : app.get_thread_model().barriers()) {
+    if(b.second != app.threads().size()) {
+      continue;
+    }
+
+    std::map<int32_t, size_t> thread_waits;
+    for(auto const &t : app.threads()) {
+      auto &count = thread_waits[t.first];
+      for(size_t index = 0; index < t.second.size(); ++index) {
+        auto const e = t.second.get_event(index);
+        if(e->get_type() == event_type::barrier_wait && e->get_object() == b.first) {
+          ++count;
+        }
+      }
+    }
+
+    auto const count = thread_waits.begin()->second;
+    bool is_global = count > *waits;
+    for(auto const &w : thread_waits) {
+      is_global = is_global && w.second == count;
+    }
+
+    if(is_global) {
+      *barrier = b.first;
+      *waits = count;
+    }
+  }
+
+  return *waits > 0;
+}
+
+phases::phases(application const &app)
+{
+  size_t waits = 0;
+  if(!find_global_barrier(app, &m_barrier, &waits)) {
+    m_starts.emplace_back();
+    m_releases.push_back(0);
+
+    return;
+  }
+
+  // for each release: where each thread waited, whether any state crosses it, and the waits at every other barrier
+  std::vector<std::map<int32_t, size_t>> wait_index(waits);
+  std::vector<bool> is_clean(waits, true);
+  std::vector<std::map<uint64_t, size_t>> barrier_waits(waits);
+
+  for(auto const &t : app.threads()) {
+    int64_t lock_depth = 0;
+    bool is_shared = false;
+    std::map<uint64_t, size_t> thread_barrier_waits;
+    size_t release = 0;
+
+    for(size_t index = 0; index < t.second.size(); ++index) {
+      auto const e = t.second.get_event(index);
+
+      switch(e->get_type()) {
+      case event_type::lock_acquire:
+        ++lock_depth;
+        break;
+      case event_type::lock_release:
+        --lock_depth;
+        break;
+      case event_type::condition_wait:
+      case event_type::condition_signal:
+      case event_type::condition_broadcast:
+      case event_type::thread_join:
+      case event_type::thread_finish:
+        // condition variable production and finished threads are remembered for the rest of the run
+        is_shared = true;
+        break;
+      case event_type::barrier_wait:
+        if(e->get_object() != m_barrier) {
+          ++thread_barrier_waits[e->get_object()];
+        } else {
+          wait_index[release][t.first] = index;
+          is_clean[release] = is_clean[release] && lock_depth == 0 && !is_shared;
+          for(auto const &w : thread_barrier_waits) {
+            barrier_waits[release][w.first] += w.second;
+          }
+
+          ++release;
+        }
+        break;
+      default:
+        break;
+      }
+    }
+  }
+
+  // every other barrier must be empty when the global barrier is released
+  auto const &barriers = app.get_thread_model().barriers();
+  for(size_t release = 0; release < waits; ++release) {
+    for(auto const &w : barrier_waits[release]) {
+      is_clean[release] = is_clean[release] && w.second % barriers.at(w.first) == 0;
+    }
+  }
+
+  // the first phase starts with the application
+  m_starts.emplace_back();
+  size_t last_release = 0;
+
+  for(size_t release = 0; release < waits; ++release) {
+    if(is_clean[release]) {
+      m_releases.push_back(release + 1 - last_release);
+      last_release = release + 1;
+
+      m_starts.emplace_back();
+      for(auto const &w : wait_index[release]) {
+        m_starts.back()[w.first] = w.second + 1;
+      }
+    }
+  }
+
+  // the last phase runs until the application finishes
+  m_releases.push_back(0);
+}
+
+/**
+ * Hash the events (but not the computations) of a phase.
+ *
+ * @param app The application.
+ * @param start The first index of each thread in the phase.
+ * @param end One past the last index of each thread in the phase.
+ *
+ * @return The hash.
+ */
+size_t hash_events(application const &app,
+    std::map<int32_t, size_t> const &start,
+    std::map<int32_t, size_t> const &end)
+{
+  size_t seed = 0;
+  auto const combine = [&seed](uint64_t const value) {
+    seed ^= std::hash<uint64_t>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  };
+
+  for(auto const &s : start) {
+    auto const &t = app.at(s.first);
+
+    combine(static_cast<uint64_t>(s.first));
+    for(auto index = s.second; index < end.at(s.first); ++index) {
+      combine(static_cast<uint64_t>(t.get_event(index)->get_type()));
+      combine(t.get_event(index)->get_object());
+    }
+  }
+
+  return seed;
+}
+
+/**
+ * Determine if a phase repeats another.
+ *
+ * @param app The application.
+ * @param first_start The first index of each thread in the earlier phase.
+ * @param first_end One past the last index of each thread in the earlier phase.
+ * @param start The first index of each thread in the phase.
+ * @param end One past the last index of each thread in the phase.
+ * @param tolerance The largest relative difference between repeated computations.
+ *
+ * @return true if the events match and the computations are within the tolerance.
+ */
+bool is_repeat(application const &app,
+    std::map<int32_t, size_t> const &first_start,
+    std::map<int32_t, size_t> const &first_end,
+    std::map<int32_t, size_t> const &start,
+    std::map<int32_t, size_t> const &end,
+    double const tolerance)
+{
+  for(auto const &s : start) {
+    auto const &t = app.at(s.first);
+    auto const first_index = first_start.at(s.first);
+    auto const size = end.at(s.first) - s.second;
+
+    if(first_end.at(s.first) - first_index != size) {
+      return false;
+    }
+
+    for(size_t offset = 0; offset < size; ++offset) {
+      auto const e = t.get_event(s.second + offset);
+      auto const first_e = t.get_event(first_index + offset);
+      if(e->get_type() != first_e->get_type() || e->get_object() != first_e->get_object()) {
+        return false;
+      }
+
+      auto const computation = static_cast<double>(t.get_computation(s.second + offset));
+      auto const first_computation = static_cast<double>(t.get_computation(first_index + offset));
+      if(std::abs(computation - first_computation) > tolerance * first_computation) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+std::vector<size_t> phases::find_repeats(application const &app, double const tolerance) const
+{
+  std::vector<size_t> repeats(size());
+  // for each hash of events, the phases that do not repeat an earlier phase
+  std::unordered_map<size_t, std::vector<size_t>> firsts;
+
+  for(size_t index = 0; index < size(); ++index) {
+    repeats[index] = index;
+    if(index == 0 || index + 1 == size()) {
+      continue;
+    }
+
+    auto const &start = m_starts[index];
+    auto const &end = m_starts[index + 1];
+
+    auto &candidates = firsts[hash_events(app, start, end)];
+    for(auto const candidate : candidates) {
+      if(is_repeat(app, m_starts[candidate], m_starts[candidate + 1], start, end, tolerance)) {
+        repeats[index] = candidate;
+        break;
+      }
+    }
+
+    if(repeats[index] == index) {
+      candidates.push_back(index);
+    }
+  }
+
+  return repeats;
+}
+}
@@ -0,0 +1,43 @@
+#include "simsync/reports/completion_time.hpp"
+
+#include "simsync/thread.hpp"
+#include "simsync/synchronization/event.hpp"
+
+#include <algorithm>
+
+namespace simsync {
+
+completion_time::completion_time(std::string const &output_file) : report(output_file)
+{
+}
+
+completion_time::~completion_time()
+{
+  m_stream << "application,completion time\n";
+  for(auto const &c : m_completion_times) {
+    m_stream << c.first << "," << std::chrono::duration_cast<std::chrono::nanoseconds>(c.second).count() << "\n";
+  }
+}
+
+void completion_time::update(picoseconds const current_time, event *e)
+{
+  auto const application_id = static_cast<size_t>(e->get_thread_id() / application_thread_stride);
+
+  m_completion_times[application_id] = current_time;
+}
+
+std::unique_ptr<report> completion_time::split(system const &) const
+{
+  return std::make_unique<completion_time>();
+}
+
+void completion_time::merge(report const &part, picoseconds const offset)
+{
+  auto const &other = static_cast<completion_time const &>(part);
+
+  for(auto const &c : other.m_completion_times) {
+    auto &time = m_completion_times[c.first];
+    time = std::max(time, offset + c.second);
+  }
+}
+}
@@ -0,0 +1,104 @@
+#include "simsync/reports/cpi_sensitivity.hpp"
+
+#include "simsync/application.hpp"
+#include "simsync/core.hpp"
+#include "simsync/system.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace simsync {
+
+cpi_sensitivity::cpi_sensitivity(std::string const &output_file, application const &app, system const &sys)
+    : report(output_file), m_application(app), m_system(sys), m_last_time(0), m_last_thread(-1)
+{
+}
+
+cpi_sensitivity::~cpi_sensitivity()
+{
+  using std::chrono::duration_cast;
+  using std::chrono::nanoseconds;
+
+  std::map<int32_t, picoseconds> time;
+  std::map<int32_t, double> derivative;
+  walk(&time, &derivative);
+
+  m_stream << "thread,critical,share,derivative\n";
+  for(auto const &t : m_application.threads()) {
+    auto const critical = time[t.first];
+    auto const share = m_last_time.count() > 0 ? static_cast<double>(critical.count()) / m_last_time.count() : 0.0;
+
+    m_stream << t.first << "," << duration_cast<nanoseconds>(critical).count() << "," << share << ","
+             << derivative[t.first] << "\n";
+  }
+}
+
+std::map<int32_t, picoseconds> cpi_sensitivity::critical_time() const
+{
+  std::map<int32_t, picoseconds> time;
+  std::map<int32_t, double> derivative;
+  walk(&time, &derivative);
+
+  return time;
+}
+
+void cpi_sensitivity::update(picoseconds current_time, event *e)
+{
+  m_last_time = current_time;
+
+  // threads that started executing since the last event waited for it
+  std::vector<int32_t> started;
+  auto const &executing = m_system.executing_threads();
+  std::set_difference(executing.begin(), executing.end(), m_executing.begin(), m_executing.end(),
+      std::back_inserter(started));
+
+  if(!started.empty() && m_last_thread != -1) {
+    auto const released_by = m_current_segment.at(m_last_thread);
+    for(auto const t : started) {
+      m_current_segment[t] = start_segment(t, released_by);
+    }
+
+    // what the releasing thread computes from now on does not delay the threads it released
+    m_current_segment[m_last_thread] = start_segment(m_last_thread, released_by);
+  }
+
+  if(!started.empty() || executing.size() != m_executing.size()) {
+    m_executing = executing;
+  }
+
+  auto const thread_id = e->get_thread_id();
+  if(m_current_segment.count(thread_id) == 0) {
+    m_current_segment[thread_id] = start_segment(thread_id, none);
+  }
+
+  // the computation leading up to this event is done
+  auto const &c = m_system.get_thread_core(thread_id);
+  auto const instructions = m_application.at(thread_id).get_computation(m_next_index[thread_id]++);
+  auto &s = m_segments[m_current_segment[thread_id]];
+  s.time += estimate_time(instructions, 0, c.get_cpi(thread_id), c.frequency());
+  s.derivative += static_cast<double>(instructions) * 1e9 / static_cast<double>(c.frequency());
+
+  m_last_thread = thread_id;
+}
+
+size_t cpi_sensitivity::start_segment(int32_t const thread_id, size_t const predecessor)
+{
+  m_segments.push_back(segment{thread_id, predecessor, picoseconds(0), 0.0});
+
+  return m_segments.size() - 1;
+}
+
+void cpi_sensitivity::walk(std::map<int32_t, picoseconds> *time, std::map<int32_t, double> *derivative) const
+{
+  if(m_last_thread == -1) {
+    return;
+  }
+
+  // the critical path ends at the last event
+  for(auto s = m_current_segment.at(m_last_thread); s != none; s = m_segments[s].predecessor) {
+    auto const &current = m_segments[s];
+    (*time)[current.thread_id] += current.time;
+    (*derivative)[current.thread_id] += current.derivative;
+  }
+}
+}
@@ -5,31 +5,45 @@
 namespace simsync {
 
 criticality_stack::criticality_stack(std::string const &output_file, const system &system)
-    : report(output_file), m_system(system), m_last_time(0)
+    : report(output_file), m_system(system)
+{
+}
+
+criticality_stack::criticality_stack(const system &system) : m_system(system)
 {
 }
 
 criticality_stack::~criticality_stack()
 {
+  using std::chrono::duration_cast;
+  using std::chrono::nanoseconds;
+
   m_stream << "thread,criticality\n";
-  for(auto const &criticality : m_criticality) {
-    m_stream << criticality.first << "," << criticality.second << "\n";
+  for(auto const &criticality : m_criticality.threads()) {
+    m_stream << criticality.first << ","
+             << duration_cast<nanoseconds>(picoseconds(criticality.second)).count() << "\n";
   }
 }
 
-void criticality_stack::update(std::chrono::nanoseconds current_time, event *)
+std::unique_ptr<report> criticality_stack::split(system const &sys) const
 {
-  auto const delta_time = current_time - m_last_time;
-  m_last_time = current_time;
+  return std::make_unique<criticality_stack>(sys);
+}
 
-  auto const total_waiting = m_system.waiting_threads().size() + m_system.sleeping_threads().size();
-  auto const total_running = m_system.executing_threads().size();
+void criticality_stack::merge(report const &part, picoseconds const offset)
+{
+  auto const &other = static_cast<criticality_stack const &>(part);
 
-  // if only one thread is running, it should not impact their criticality
-  if(total_running > 1 && total_waiting > 0) {
-    for(auto const &t : m_system.executing_threads()) {
-      m_criticality[t] += delta_time.count() / static_cast<int64_t>(total_waiting);
-    }
-  }
+  m_criticality.merge(other.m_criticality, offset);
+}
+
+void criticality_stack::preempt(picoseconds const current_time)
+{
+  update(current_time, nullptr);
+}
+
+void criticality_stack::update(picoseconds current_time, event *)
+{
+  m_criticality.update(current_time, m_system);
 }
 }
@@ -0,0 +1,37 @@
+#include "simsync/reports/energy_use.hpp"
+
+#include "simsync/system.hpp"
+
+namespace simsync {
+
+energy_use::energy_use(std::string const &output_file, system const &sys)
+    : report(output_file), m_system(sys), m_last_time(0)
+{
+}
+
+energy_use::~energy_use()
+{
+  auto const totals = m_system.energy(m_last_time);
+  auto const seconds = std::chrono::duration<double>(m_last_time).count();
+
+  double total = 0.0;
+  m_stream << "component,id,value\n";
+  for(size_t core_id = 0; core_id < totals.cores.size(); ++core_id) {
+    m_stream << "core," << core_id << "," << totals.cores[core_id] << "\n";
+    total += totals.cores[core_id];
+  }
+
+  for(auto const &t : totals.threads) {
+    m_stream << "thread," << t.first << "," << t.second << "\n";
+  }
+
+  m_stream << "energy,," << total << "\n";
+  m_stream << "time,," << seconds << "\n";
+  m_stream << "edp,," << total * seconds << "\n";
+}
+
+void energy_use::update(picoseconds const current_time, event *)
+{
+  m_last_time = current_time;
+}
+}
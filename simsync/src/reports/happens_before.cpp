@@ -0,0 +1,185 @@
+#include "simsync/reports/happens_before.hpp"
+
+#include "simsync/application.hpp"
+#include "simsync/architecture.hpp"
+#include "simsync/core.hpp"
+#include "simsync/core_type.hpp"
+#include "simsync/system.hpp"
+#include "simsync/synchronization/event.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+namespace simsync {
+
+happens_before::happens_before(std::string const &output_file, application const &app, system const &sys)
+    : report(output_file), m_application(app), m_system(sys), m_last_event(none)
+{
+  // barrier releases have no thread or core
+  m_slots.emplace_back(0, -1);
+  m_first_dependency.push_back(0);
+}
+
+happens_before::~happens_before()
+{
+  auto const as_signed = [](uint32_t const node) { return node == none ? -1 : static_cast<int64_t>(node); };
+
+  m_stream << "node,thread,core,instructions,previous,dependencies\n";
+  for(size_t node = 0; node < m_slot.size(); ++node) {
+    auto const &slot = m_slots[m_slot[node]];
+
+    m_stream << node << "," << slot.second << "," << (slot.second == -1 ? -1 : static_cast<int64_t>(slot.first))
+             << "," << m_instructions[node] << "," << as_signed(m_previous[node]) << ",";
+    for(auto d = m_first_dependency[node]; d < m_first_dependency[node + 1]; ++d) {
+      m_stream << (d == m_first_dependency[node] ? "" : " ") << m_dependencies[d];
+    }
+    m_stream << "\n";
+  }
+}
+
+void happens_before::update(picoseconds, event *e)
+{
+  // threads that started executing since the last event were woken by it, or given the core it freed
+  std::vector<int32_t> started;
+  auto const &executing = m_system.executing_threads();
+  std::set_difference(executing.begin(), executing.end(), m_executing.begin(), m_executing.end(),
+      std::back_inserter(started));
+
+  if(m_last_event != none) {
+    for(auto const t : started) {
+      m_pending[t].push_back(m_last_event);
+    }
+  }
+
+  if(!started.empty() || executing.size() != m_executing.size()) {
+    m_executing = executing;
+  }
+
+  auto const thread_id = e->get_thread_id();
+  auto const slot = get_slot(m_system.get_thread_core_id(thread_id), thread_id);
+  auto const instructions = m_application.at(thread_id).get_computation(m_next_index[thread_id]++);
+
+  auto const previous = m_last_node.find(thread_id);
+  auto &pending = m_pending[thread_id];
+  auto const node = add_node(slot, instructions, previous != m_last_node.end() ? previous->second : none, pending);
+  pending.clear();
+  m_last_node[thread_id] = node;
+
+  auto const object = e->get_object();
+  switch(e->get_type()) {
+  case event_type::lock_acquire: {
+    // if the lock was free, the thread still had to wait for its last release
+    auto const release = m_last_release.find(object);
+    if(release != m_last_release.end()) {
+      pending.push_back(release->second);
+    }
+
+    auto const request = m_last_request.find(object);
+    if(request != m_last_request.end()) {
+      m_lock_requests.emplace_back(request->second, node);
+    }
+    m_last_request[object] = node;
+    break;
+  }
+  case event_type::lock_release:
+    m_last_release[object] = node;
+    break;
+  case event_type::barrier_wait: {
+    auto &arrivals = m_arrivals[object];
+    arrivals.push_back(node);
+
+    if(arrivals.size() == m_application.get_thread_model().barriers().at(object)) {
+      // the barrier is released once every thread has arrived
+      auto const release = add_node(0, 0, none, arrivals);
+      for(auto const arrival : arrivals) {
+        m_pending[m_slots[m_slot[arrival]].second].push_back(release);
+      }
+
+      arrivals.clear();
+    }
+    break;
+  }
+  case event_type::thread_join: {
+    auto const finish = m_finish.find(static_cast<int32_t>(object));
+    if(finish != m_finish.end()) {
+      pending.push_back(finish->second);
+    }
+    break;
+  }
+  case event_type::thread_finish:
+    m_finish[thread_id] = node;
+    break;
+  default:
+    break;
+  }
+
+  m_last_event = node;
+}
+
+replay_result happens_before::replay(architecture const &arch, system const &sys) const
+{
+  if(m_system.migration_penalty() > 0 || sys.migration_penalty() > 0) {
+    throw std::runtime_error("Error: happens-before graphs cannot be replayed with migration penalties.");
+  }
+
+  // the time each distinct pair of core and thread takes per instruction
+  std::vector<fixed_cpi> cpi(m_slots.size(), 0);
+  std::vector<int64_t> frequency(m_slots.size(), 1);
+  for(size_t slot = 1; slot < m_slots.size(); ++slot) {
+    auto const &c = arch.get_core(m_slots[slot].first);
+    cpi[slot] = c.get_cpi(m_slots[slot].second);
+    frequency[slot] = c.type().get_frequency(sys.static_frequency(m_slots[slot].second));
+  }
+
+  // nodes were added in the order they were simulated, so every dependency comes before the node
+  std::vector<int64_t> completion(m_slot.size());
+  int64_t end = 0;
+  for(size_t node = 0; node < m_slot.size(); ++node) {
+    int64_t start = m_previous[node] != none ? completion[m_previous[node]] : 0;
+    for(auto d = m_first_dependency[node]; d < m_first_dependency[node + 1]; ++d) {
+      start = std::max(start, completion[m_dependencies[d]]);
+    }
+
+    auto const slot = m_slot[node];
+    completion[node] = start + estimate_time(m_instructions[node], 0, cpi[slot], frequency[slot]).count();
+    end = std::max(end, completion[node]);
+  }
+
+  // lock requests are granted in the order they are made
+  size_t reordered = 0;
+  for(auto const &r : m_lock_requests) {
+    if(completion[r.second] < completion[r.first]) {
+      ++reordered;
+    }
+  }
+
+  return replay_result{std::chrono::duration_cast<std::chrono::nanoseconds>(picoseconds(end)), reordered};
+}
+
+uint32_t happens_before::add_node(
+    uint32_t const slot, uint64_t const instructions, uint32_t const previous, std::vector<uint32_t> const &dependencies)
+{
+  m_slot.push_back(slot);
+  m_instructions.push_back(instructions);
+  m_previous.push_back(previous);
+  m_dependencies.insert(m_dependencies.end(), dependencies.begin(), dependencies.end());
+  m_first_dependency.push_back(static_cast<uint32_t>(m_dependencies.size()));
+
+  return static_cast<uint32_t>(m_slot.size() - 1);
+}
+
+uint32_t happens_before::get_slot(size_t const core_id, int32_t const thread_id)
+{
+  auto const key = std::make_pair(core_id, thread_id);
+  auto const slot = m_slot_index.find(key);
+  if(slot != m_slot_index.end()) {
+    return slot->second;
+  }
+
+  m_slots.push_back(key);
+  m_slot_index.emplace(key, static_cast<uint32_t>(m_slots.size() - 1));
+
+  return static_cast<uint32_t>(m_slots.size() - 1);
+}
+}
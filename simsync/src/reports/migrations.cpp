@@ -0,0 +1,29 @@
+#include "simsync/reports/migrations.hpp"
+
+#include "simsync/synchronization/event.hpp"
+#include "simsync/system.hpp"
+
+namespace simsync {
+
+migrations::migrations(std::string const &output_file, system const &sys) : report(output_file), m_system(sys)
+{
+}
+
+migrations::~migrations()
+{
+  auto const &counts = m_system.migrations();
+
+  m_stream << "thread,migrations,warm-up instructions\n";
+  for(auto const t : m_threads) {
+    auto const count_it = counts.find(t);
+    auto const count = count_it != counts.end() ? count_it->second : 0;
+
+    m_stream << t << "," << count << "," << static_cast<int64_t>(count) * m_system.migration_penalty() << "\n";
+  }
+}
+
+void migrations::update(picoseconds, event *e)
+{
+  m_threads.insert(e->get_thread_id());
+}
+}
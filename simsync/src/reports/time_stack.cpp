@@ -9,19 +9,50 @@ time_stack::time_stack(const std::string &output_file, system const &sys)
 {
 }
 
+time_stack::time_stack(system const &sys) : m_system(sys), m_last_time(0)
+{
+}
+
 time_stack::~time_stack()
 {
+  using std::chrono::duration_cast;
+  using std::chrono::nanoseconds;
+
   m_stream << "thread,computation,synchronization,waiting,total\n";
   for(auto const &w : m_wrappers) {
     m_stream << w.first << ",";
-    m_stream << w.second.compute.count() << ",";
-    m_stream << w.second.sync.count() << ",";
-    m_stream << w.second.wait.count() << ",";
-    m_stream << (w.second.compute.count() + w.second.sync.count() + w.second.wait.count()) << "\n";
+    m_stream << duration_cast<nanoseconds>(w.second.compute).count() << ",";
+    m_stream << duration_cast<nanoseconds>(w.second.sync).count() << ",";
+    m_stream << duration_cast<nanoseconds>(w.second.wait).count() << ",";
+    m_stream << duration_cast<nanoseconds>(w.second.compute + w.second.sync + w.second.wait).count() << "\n";
+  }
+}
+
+std::unique_ptr<report> time_stack::split(system const &sys) const
+{
+  return std::make_unique<time_stack>(sys);
+}
+
+void time_stack::merge(report const &part, picoseconds const offset)
+{
+  auto const &other = static_cast<time_stack const &>(part);
+
+  for(auto const &w : other.m_wrappers) {
+    auto &wrapper = m_wrappers[w.first];
+    wrapper.compute += w.second.compute;
+    wrapper.sync += w.second.sync;
+    wrapper.wait += w.second.wait;
   }
+
+  m_last_time = offset + other.m_last_time;
+}
+
+void time_stack::preempt(picoseconds const current_time)
+{
+  update(current_time, nullptr);
 }
 
-void time_stack::update(std::chrono::nanoseconds current_time, event *)
+void time_stack::update(picoseconds current_time, event *)
 {
   auto const delta_time = current_time - m_last_time;
   m_last_time = current_time;
@@ -0,0 +1,153 @@
+#include "simsync/scheduler_policy.hpp"
+
+#include "simsync/architecture.hpp"
+#include "simsync/core.hpp"
+#include "simsync/core_type.hpp"
+#include "simsync/system.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace simsync {
+
+/**
+ * Get the time a thread takes per instruction on a core, up to a constant factor.
+ *
+ * @param thread_id The thread.
+ * @param core_id The core.
+ * @param sys The operating system, which determines the thread's frequency level.
+ *
+ * @return The thread's CPI on the core divided by the frequency it would run the core at.
+ */
+double time_per_instruction(int32_t const thread_id, size_t const core_id, system const &sys)
+{
+  auto const &type = sys.get_architecture().get_core(core_id).type();
+
+  return static_cast<double>(type.get_cpi(thread_id)) /
+         static_cast<double>(type.get_frequency(sys.static_frequency(thread_id)));
+}
+
+/**
+ * Find the available core a thread executes fastest or slowest on.
+ *
+ * @param thread_id The thread.
+ * @param available The available cores.
+ * @param sys The operating system.
+ * @param fastest true to find the fastest core, otherwise the slowest.
+ *
+ * @return The position of the first such core in available.
+ */
+size_t find_core(int32_t const thread_id, std::deque<size_t> const &available, system const &sys, bool const fastest)
+{
+  size_t chosen = 0;
+  auto chosen_time = time_per_instruction(thread_id, available[0], sys);
+
+  for(size_t position = 1; position < available.size(); ++position) {
+    auto const time = time_per_instruction(thread_id, available[position], sys);
+    if(fastest ? time < chosen_time : time > chosen_time) {
+      chosen = position;
+      chosen_time = time;
+    }
+  }
+
+  return chosen;
+}
+
+std::unique_ptr<scheduler_policy> fifo_policy::clone() const
+{
+  return std::make_unique<fifo_policy>(*this);
+}
+
+size_t fifo_policy::choose_core(int32_t, std::deque<size_t> const &, system const &) const
+{
+  return 0;
+}
+
+std::unique_ptr<scheduler_policy> fastest_core_policy::clone() const
+{
+  return std::make_unique<fastest_core_policy>(*this);
+}
+
+size_t fastest_core_policy::choose_core(
+    int32_t const thread_id, std::deque<size_t> const &available, system const &sys) const
+{
+  return find_core(thread_id, available, sys, true);
+}
+
+std::unique_ptr<scheduler_policy> criticality_policy::clone() const
+{
+  return std::make_unique<criticality_policy>(*this);
+}
+
+size_t criticality_policy::choose_core(
+    int32_t const thread_id, std::deque<size_t> const &available, system const &sys) const
+{
+  // the average is over the threads that have accumulated any criticality
+  auto const threads = static_cast<int64_t>(std::max<size_t>(m_criticality.threads().size(), 1));
+  auto const is_critical = m_criticality.criticality(thread_id) * threads >= m_criticality.total();
+
+  return find_core(thread_id, available, sys, is_critical);
+}
+
+size_t criticality_policy::choose_thread(std::deque<int32_t> const &waiting, system const &) const
+{
+  size_t chosen = 0;
+  int64_t chosen_criticality = -1;
+
+  for(size_t position = 0; position < waiting.size(); ++position) {
+    auto const criticality = m_criticality.criticality(waiting[position]);
+    if(criticality > chosen_criticality) {
+      chosen = position;
+      chosen_criticality = criticality;
+    }
+  }
+
+  return chosen;
+}
+
+void criticality_policy::update(picoseconds const current_time, system const &sys)
+{
+  m_criticality.update(current_time, sys);
+}
+
+void criticality_policy::restore(scheduler_policy const &other, picoseconds const current_time)
+{
+  auto const criticality = dynamic_cast<criticality_policy const *>(&other);
+  m_criticality = criticality != nullptr ? criticality->m_criticality : criticality_accumulator(current_time);
+}
+
+std::unique_ptr<scheduler_policy> sticky_policy::clone() const
+{
+  return std::make_unique<sticky_policy>(*this);
+}
+
+size_t sticky_policy::choose_core(
+    int32_t const thread_id, std::deque<size_t> const &available, system const &sys) const
+{
+  auto const last_core = sys.last_cores().find(thread_id);
+  if(last_core != sys.last_cores().end()) {
+    for(size_t position = 0; position < available.size(); ++position) {
+      if(available[position] == last_core->second) {
+        return position;
+      }
+    }
+  }
+
+  return 0;
+}
+
+std::unique_ptr<scheduler_policy> make_scheduler_policy(std::string const &name)
+{
+  if(name == "fifo") {
+    return std::make_unique<fifo_policy>();
+  } else if(name == "fastest-core") {
+    return std::make_unique<fastest_core_policy>();
+  } else if(name == "criticality") {
+    return std::make_unique<criticality_policy>();
+  } else if(name == "sticky") {
+    return std::make_unique<sticky_policy>();
+  }
+
+  throw std::runtime_error("Error: unknown scheduler policy " + name + ".");
+}
+}
@@ -0,0 +1,443 @@
+#include "simsync/simulation.hpp"
+
+#include "simsync/application.hpp"
+#include "simsync/core.hpp"
+#include "simsync/reports/criticality_stack.hpp"
+#include "simsync/reports/report.hpp"
+#include "simsync/reports/time_stack.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace simsync {
+
+/**
+ * Updates reports chosen at run time, with a virtual call per report.
+ */
+struct dynamic_reports {
+  std::deque<std::unique_ptr<report>> const &reports;
+
+  void update(picoseconds const current_time, event *const e)
+  {
+    for(auto &r : reports) {
+      r->update(current_time, e);
+    }
+  }
+
+  void preempt(picoseconds const current_time)
+  {
+    for(auto &r : reports) {
+      r->preempt(current_time);
+    }
+  }
+};
+
+// the reports of simulations that have none
+std::deque<std::unique_ptr<report>> const no_reports;
+
+// how many events to process between checks of the wall time for progress reports
+constexpr uint64_t progress_poll_events = 1024;
+
+simulation::simulation(application const &app, system &sys, std::deque<std::unique_ptr<report>> const &reports)
+    : simulation(app, sys, reports, app.masters())
+{
+}
+
+simulation::simulation(application const &app, system &sys) : simulation(app, sys, no_reports, app.masters())
+{
+}
+
+simulation::simulation(application const &app,
+    system &sys,
+    std::deque<std::unique_ptr<report>> const &reports,
+    std::map<int32_t, size_t> const &start)
+    : m_app(app)
+    , m_thread_model(app.get_thread_model())
+    , m_system(sys)
+    , m_reports(reports)
+    , m_threads(app.threads())
+    , m_time(0)
+    , m_cancelled(false)
+{
+  this->start(start);
+}
+
+simulation::simulation(application const &app,
+    checkpoint const &from,
+    system &sys,
+    std::deque<std::unique_ptr<report>> const &reports)
+    : m_app(app)
+    , m_thread_model(from.m_thread_model)
+    , m_system(sys)
+    , m_reports(reports)
+    , m_threads(from.m_threads)
+    , m_time(from.m_time)
+    , m_events(from.m_events)
+    , m_cancelled(false)
+{
+  if(from.m_sampler != nullptr) {
+    m_sampler = std::make_unique<cpi_sampler>(*from.m_sampler);
+  }
+  m_threads.sample_cpi(m_sampler.get());
+
+  m_system.restore(from.m_system);
+  m_system.govern(m_thread_model);
+  m_system.take_changes(&m_changes);
+  for(auto const &t : m_system.executing_threads()) {
+    m_threads.retime(t, m_system.get_thread_core(t));
+  }
+
+  for(size_t r = 0; r < m_reports.size() && r < from.m_reports.size(); ++r) {
+    if(from.m_reports[r] != nullptr) {
+      m_reports[r]->merge(*from.m_reports[r], picoseconds(0));
+    }
+  }
+}
+
+bool simulation::step(uint64_t const events)
+{
+  m_event_limit = events < std::numeric_limits<uint64_t>::max() - m_events ? m_events + events
+                                                                          : std::numeric_limits<uint64_t>::max();
+  process();
+  m_event_limit = std::numeric_limits<uint64_t>::max();
+
+  return finished();
+}
+
+bool simulation::run_until(picoseconds const time)
+{
+  m_time_limit = time;
+  process();
+  m_time_limit = picoseconds::max();
+
+  return finished();
+}
+
+bool simulation::run_until_release(uint64_t const barrier, size_t const releases)
+{
+  m_stop_barrier = barrier;
+  m_stop_releases = releases;
+  process();
+  m_stop_releases = 0;
+
+  return finished();
+}
+
+std::chrono::nanoseconds simulation::run()
+{
+  process();
+
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(m_time);
+}
+
+template <typename... Reports>
+std::chrono::nanoseconds simulation::run(report_set<Reports...> &reports)
+{
+  process(reports);
+
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(m_time);
+}
+
+#define SIMSYNC_INSTANTIATE_RUN(...) template std::chrono::nanoseconds simulation::run(report_set<__VA_ARGS__> &);
+SIMSYNC_FOR_EACH_REPORT_SET(SIMSYNC_INSTANTIATE_RUN)
+#undef SIMSYNC_INSTANTIATE_RUN
+
+void simulation::on_progress(std::function<void(progress const &)> callback, std::chrono::milliseconds const interval)
+{
+  m_progress = std::move(callback);
+  m_progress_interval = interval;
+  m_next_progress_poll = m_events + progress_poll_events;
+  m_progress_start_events = m_events;
+  m_progress_start = m_last_progress = clock::now();
+}
+
+void simulation::take_checkpoints(checkpoint_options const &options)
+{
+  if(m_hot_locks != nullptr) {
+    throw std::runtime_error("Error: checkpoints cannot be taken while approximating hot locks.");
+  }
+
+  m_checkpoints = options;
+  m_next_checkpoint_time = m_time + options.interval;
+  m_next_checkpoint_events = m_events + options.events;
+}
+
+void simulation::sample_cpi(uint64_t const seed)
+{
+  if(m_events > 0) {
+    throw std::runtime_error("Error: CPI sampling must start before any event is processed.");
+  }
+
+  m_sampler = std::make_unique<cpi_sampler>(seed);
+  m_threads.sample_cpi(m_sampler.get());
+
+  // threads that have already started are timed again with their sampled CPI
+  for(auto const &t : m_system.executing_threads()) {
+    m_threads.seek(t, m_threads.current_index(t));
+  }
+}
+
+void simulation::approximate_hot_locks(hot_lock_options const &options)
+{
+  if(m_checkpoints.checkpoints != nullptr) {
+    throw std::runtime_error("Error: checkpoints cannot be taken while approximating hot locks.");
+  }
+
+  m_hot_locks = std::make_unique<hot_lock_model>(m_app, options);
+}
+
+void simulation::start(std::map<int32_t, size_t> const &start)
+{
+  transition state_changes{};
+  for(auto const &s : start) {
+    m_threads.seek(s.first, s.second);
+    state_changes.to_wake.insert(s.first);
+  }
+
+  apply(state_changes);
+}
+
+void simulation::process()
+{
+  dynamic_reports observer{m_reports};
+  process(observer);
+}
+
+template <typename Observer>
+void simulation::process(Observer &observer)
+{
+  size_t releases = 0;
+
+  while(m_threads.executing() > 0 && !should_stop()) {
+    event *current_event = nullptr;
+    transition state_changes{};
+
+    if(m_threads.executing() == 1 && m_system.waiting_threads().empty() && m_hot_locks == nullptr &&
+        m_system.next_governor_update() == picoseconds::max()) {
+      if(!run_serial(observer, *m_system.executing_threads().begin(), &current_event, &state_changes)) {
+        break;
+      }
+    } else {
+      picoseconds elapsed_time = picoseconds(0);
+
+      // determine the next thread that will complete
+      auto const current_thread = m_threads.next_thread(&elapsed_time);
+
+      // a scheduler tick that comes before the next event preempts threads instead, and a governor tick rescales cores
+      auto const preemption = m_system.next_preemption();
+      auto const tick = std::min(preemption, m_system.next_governor_update());
+      if(tick < m_time + elapsed_time) {
+        if(tick > m_time_limit) {
+          break;
+        }
+
+        m_threads.elapse(tick - m_time);
+        m_time = tick;
+
+        if(tick == preemption) {
+          observer.preempt(m_time);
+          m_system.update(m_time);
+          m_system.preempt();
+        }
+        apply(transition{});
+
+        continue;
+      }
+
+      if(m_time + elapsed_time > m_time_limit) {
+        break;
+      }
+
+      auto const current_index = m_threads.current_index(current_thread);
+      current_event = m_app.at(current_thread).get_event(current_index);
+
+      // progress time of all currently executing threads
+      m_threads.progress(current_thread, elapsed_time);
+      m_time += elapsed_time;
+
+      state_changes = synchronize(observer, current_event);
+
+      if(m_hot_locks != nullptr) {
+        // a thread that acquires an approximated lock waits for it before its next computation
+        auto const wait = m_hot_locks->update(m_time, *current_event, m_thread_model);
+        if(wait.count() > 0) {
+          m_threads.delay(current_thread, wait);
+        }
+      }
+    }
+
+    // schedule threads based on synchronization state changes
+    apply(state_changes);
+
+    if(m_checkpoints.checkpoints != nullptr) {
+      checkpoint_if_due();
+    }
+
+    if(m_stop_releases > 0 && current_event->get_type() == event_type::barrier_wait &&
+        current_event->get_object() == m_stop_barrier && !state_changes.to_wake.empty()) {
+      if(++releases == m_stop_releases) {
+        break;
+      }
+    }
+  }
+}
+
+bool simulation::should_stop()
+{
+  if(m_progress && m_events >= m_next_progress_poll) {
+    m_next_progress_poll = m_events + progress_poll_events;
+    report_progress();
+  }
+
+  return m_events >= m_event_limit || m_cancelled.load(std::memory_order_relaxed);
+}
+
+void simulation::report_progress()
+{
+  auto const now = clock::now();
+  if(now - m_last_progress < m_progress_interval) {
+    return;
+  }
+  m_last_progress = now;
+
+  auto const wall_time = std::chrono::duration<double>(now - m_progress_start).count();
+  auto const events = static_cast<double>(m_events - m_progress_start_events);
+
+  m_progress(progress{m_events, std::chrono::duration_cast<std::chrono::nanoseconds>(m_time),
+      wall_time > 0 ? events / wall_time : 0.0});
+}
+
+void simulation::checkpoint_if_due()
+{
+  bool is_due = false;
+
+  if(m_checkpoints.interval.count() > 0 && m_time >= m_next_checkpoint_time) {
+    is_due = true;
+    while(m_next_checkpoint_time <= m_time) {
+      m_next_checkpoint_time += m_checkpoints.interval;
+    }
+  }
+
+  if(m_checkpoints.events > 0 && m_events >= m_next_checkpoint_events) {
+    is_due = true;
+    while(m_next_checkpoint_events <= m_events) {
+      m_next_checkpoint_events += m_checkpoints.events;
+    }
+  }
+
+  if(is_due) {
+    m_checkpoints.checkpoints->emplace_back(
+        new checkpoint(m_time, m_events, m_thread_model, m_threads, m_sampler.get(), m_system, m_reports));
+  }
+}
+
+/**
+ * Update reports and synchronization state for an event that has been reached.
+ *
+ * @param observer The reports to update.
+ * @param current_event The event.
+ *
+ * @return The resulting state changes.
+ */
+template <typename Observer>
+transition simulation::synchronize(Observer &observer, event *current_event)
+{
+  observer.update(m_time, current_event);
+  ++m_events;
+
+  return current_event->synchronize(m_thread_model);
+}
+
+/**
+ * Run the only executing thread until one of its events changes the state of any thread, or the run should stop.
+ *
+ * With a single executing thread and no threads waiting for a core, each computation takes exactly its own execution
+ * time, so there is no need to search for the next thread or progress others.
+ *
+ * @param observer The reports to update.
+ * @param thread_id The only executing thread.
+ * @param[out] last_event The last event processed.
+ * @param[out] state_changes The state changes from the last event.
+ *
+ * @return false if the run stopped before any event was processed.
+ */
+template <typename Observer>
+bool simulation::run_serial(
+    Observer &observer, int32_t const thread_id, event **last_event, transition *state_changes)
+{
+  auto const &c = m_system.get_thread_core(thread_id);
+  auto const cpi = c.get_cpi(thread_id);
+  auto const cpi_stddev = c.get_cpi_stddev(thread_id);
+  auto const frequency = c.frequency();
+  auto const &t = m_app.at(thread_id);
+
+  auto const remaining = m_threads.time_remaining(thread_id);
+  if(m_time + remaining > m_time_limit) {
+    return false;
+  }
+  m_time += remaining;
+
+  auto index = m_threads.current_index(thread_id);
+  while(true) {
+    *last_event = t.get_event(index);
+
+    *state_changes = synchronize(observer, *last_event);
+    ++index;
+
+    if(!state_changes->to_sleep.empty() || !state_changes->to_wake.empty() || state_changes->finished != -1) {
+      m_threads.seek(thread_id, index);
+      return true;
+    }
+
+    auto const computation_cpi = m_sampler != nullptr ? m_sampler->sample(cpi, cpi_stddev, thread_id, index) : cpi;
+    auto const computation_time = estimate_time(t.get_computation(index), 0, computation_cpi, frequency);
+    if(m_time + computation_time > m_time_limit || should_stop()) {
+      // the thread has not started its next computation yet
+      m_threads.seek(thread_id, index);
+      return true;
+    }
+
+    m_time += computation_time;
+  }
+}
+
+/**
+ * Schedule threads based on synchronization state changes.
+ *
+ * @param state_changes The result of synchronizing an event.
+ */
+void simulation::apply(transition const &state_changes)
+{
+  m_system.update(m_time);
+  m_system.sleep(state_changes.to_sleep);
+  m_system.schedule(state_changes.to_wake);
+  if(state_changes.finished != -1) {
+    m_system.erase(state_changes.finished);
+  }
+
+  m_system.govern(m_thread_model);
+
+  m_system.take_changes(&m_changes);
+  for(auto const &change : m_changes) {
+    // a thread may start and stop, or be rescaled and stop, in the same change, so its core is found by index
+    auto const &c = m_system.get_architecture().get_core(change.core_id);
+    if(change.rescaled) {
+      m_threads.retime(change.thread_id, c);
+    } else if(change.executing) {
+      m_threads.start(change.thread_id, c);
+      if(change.switched && m_system.context_switch().count() > 0) {
+        m_threads.delay(change.thread_id, m_system.context_switch());
+      }
+      if(change.migrated && m_system.migration_penalty() > 0) {
+        // the thread warms up its new core before it continues
+        m_threads.extend(change.thread_id,
+            estimate_time(m_system.migration_penalty(), 0, c.get_cpi(change.thread_id), c.frequency()));
+      }
+    } else if(change.switched) {
+      m_threads.suspend(change.thread_id);
+    } else {
+      m_threads.stop(change.thread_id);
+    }
+  }
+}
+}
@@ -0,0 +1,60 @@
+#include "simsync/sweep.hpp"
+
+#include "simsync/architecture.hpp"
+#include "simsync/estimate.hpp"
+#include "simsync/parallel.hpp"
+#include "simsync/reports/report.hpp"
+#include "simsync/system.hpp"
+
+#include <atomic>
+
+namespace simsync {
+
+using std::chrono::nanoseconds;
+
+std::vector<sweep_result> sweep(
+    application const &app, std::vector<std::string> const &configs, sweep_options const &options)
+{
+  std::vector<sweep_result> results(configs.size());
+
+  auto const no_deadline = std::chrono::duration_cast<nanoseconds>(picoseconds::max());
+  std::atomic<nanoseconds::rep> fastest(options.deadline.count() > 0 ? options.deadline.count() : no_deadline.count());
+
+  parallel_for(configs.size(), options.workers, [&](size_t const index) {
+    auto const &config = configs[index];
+
+    architecture arch(config);
+    system sys(config, arch);
+    if(!options.scheduler.empty()) {
+      sys.set_scheduler(make_scheduler_policy(options.scheduler));
+    }
+    if(!options.governor.empty()) {
+      sys.set_governor(make_frequency_governor(options.governor, {}));
+    }
+    if(options.migration_penalty >= 0) {
+      sys.set_migration_penalty(options.migration_penalty);
+    }
+    if(options.timeslice.count() >= 0 || options.context_switch.count() >= 0) {
+      sys.set_preemption(options.timeslice.count() >= 0 ? options.timeslice : sys.timeslice(),
+          options.context_switch.count() >= 0 ? options.context_switch : sys.context_switch());
+    }
+
+    auto const deadline = nanoseconds(fastest.load());
+    auto const time = estimate(app, sys, {}, deadline);
+
+    results[index].config = config;
+    results[index].cores = arch.size();
+    results[index].execution_time = time;
+    results[index].complete = time <= deadline;
+
+    if(options.prune && results[index].complete) {
+      // a configuration is only of interest if it beats every one finished so far
+      auto current = fastest.load();
+      while(time.count() < current && !fastest.compare_exchange_weak(current, time.count())) {
+      }
+    }
+  });
+
+  return results;
+}
+}
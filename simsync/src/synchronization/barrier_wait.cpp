@@ -5,14 +5,19 @@
 #include <ostream>
 
 namespace simsync {
-barrier_wait::barrier_wait(int32_t thread_id, thread_model &tm, uint64_t barrier_address)
-    : event(thread_id, tm), m_barrier_address(barrier_address)
+barrier_wait::barrier_wait(int32_t thread_id, uint64_t barrier_address)
+    : event(thread_id, event_type::barrier_wait), m_barrier_address(barrier_address)
 {
 }
 
-transition barrier_wait::synchronize()
+transition barrier_wait::synchronize(thread_model &tm) const
 {
-  return m_thread_model.barrier_wait(m_thread_id, m_barrier_address);
+  return tm.barrier_wait(m_thread_id, m_barrier_address);
+}
+
+uint64_t barrier_wait::get_object() const
+{
+  return m_barrier_address;
 }
 
 void barrier_wait::print(std::ostream &stream) const
@@ -6,14 +6,19 @@
 
 namespace simsync {
 
-condition_broadcast::condition_broadcast(int32_t thread_id, thread_model &tm, uint64_t condition_address)
-    : event(thread_id, tm), m_condition_address(condition_address)
+condition_broadcast::condition_broadcast(int32_t thread_id, uint64_t condition_address)
+    : event(thread_id, event_type::condition_broadcast), m_condition_address(condition_address)
 {
 }
 
-transition condition_broadcast::synchronize()
+transition condition_broadcast::synchronize(thread_model &tm) const
 {
-  return m_thread_model.condition_broadcast(m_condition_address);
+  return tm.condition_broadcast(m_condition_address);
+}
+
+uint64_t condition_broadcast::get_object() const
+{
+  return m_condition_address;
 }
 
 void condition_broadcast::print(std::ostream &stream) const
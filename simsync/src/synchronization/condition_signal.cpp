@@ -6,14 +6,19 @@
 
 namespace simsync {
 
-condition_signal::condition_signal(int32_t thread_id, thread_model &tm, uint64_t condition_address)
-    : event(thread_id, tm), m_condition_address(condition_address)
+condition_signal::condition_signal(int32_t thread_id, uint64_t condition_address)
+    : event(thread_id, event_type::condition_signal), m_condition_address(condition_address)
 {
 }
 
-transition condition_signal::synchronize()
+transition condition_signal::synchronize(thread_model &tm) const
 {
-  return m_thread_model.condition_signal(m_condition_address);
+  return tm.condition_signal(m_condition_address);
+}
+
+uint64_t condition_signal::get_object() const
+{
+  return m_condition_address;
 }
 
 void condition_signal::print(std::ostream &stream) const
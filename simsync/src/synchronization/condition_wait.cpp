@@ -6,14 +6,19 @@
 
 namespace simsync {
 
-condition_wait::condition_wait(int32_t thread_id, thread_model &tm, uint64_t condition_address)
-    : event(thread_id, tm), m_condition_address(condition_address)
+condition_wait::condition_wait(int32_t thread_id, uint64_t condition_address)
+    : event(thread_id, event_type::condition_wait), m_condition_address(condition_address)
 {
 }
 
-transition condition_wait::synchronize()
+transition condition_wait::synchronize(thread_model &tm) const
 {
-  return m_thread_model.condition_wait(m_thread_id, m_condition_address);
+  return tm.condition_wait(m_thread_id, m_condition_address);
+}
+
+uint64_t condition_wait::get_object() const
+{
+  return m_condition_address;
 }
 
 void condition_wait::print(std::ostream &stream) const
@@ -2,7 +2,7 @@
 
 namespace simsync {
 
-event::event(int32_t const thread_id, thread_model &tm) : m_thread_id(thread_id), m_thread_model(tm)
+event::event(int32_t const thread_id, event_type const type) : m_thread_id(thread_id), m_type(type)
 {
 }
 }
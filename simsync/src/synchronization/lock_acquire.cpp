@@ -6,14 +6,19 @@
 
 namespace simsync {
 
-lock_acquire::lock_acquire(int32_t thread_id, thread_model &tm, uint64_t lock_address)
-    : event(thread_id, tm), m_lock_address(lock_address)
+lock_acquire::lock_acquire(int32_t thread_id, uint64_t lock_address)
+    : event(thread_id, event_type::lock_acquire), m_lock_address(lock_address)
 {
 }
 
-transition lock_acquire::synchronize()
+transition lock_acquire::synchronize(thread_model &tm) const
 {
-  return m_thread_model.acquire(m_thread_id, m_lock_address);
+  return tm.acquire(m_thread_id, m_lock_address);
+}
+
+uint64_t lock_acquire::get_object() const
+{
+  return m_lock_address;
 }
 
 void lock_acquire::print(std::ostream &stream) const
@@ -6,14 +6,19 @@
 
 namespace simsync {
 
-lock_release::lock_release(int32_t thread_id, thread_model &tm, uint64_t lock_address)
-    : event(thread_id, tm), m_lock_address(lock_address)
+lock_release::lock_release(int32_t thread_id, uint64_t lock_address)
+    : event(thread_id, event_type::lock_release), m_lock_address(lock_address)
 {
 }
 
-transition lock_release::synchronize()
+transition lock_release::synchronize(thread_model &tm) const
 {
-  return m_thread_model.release(m_thread_id, m_lock_address);
+  return tm.release(m_thread_id, m_lock_address);
+}
+
+uint64_t lock_release::get_object() const
+{
+  return m_lock_address;
 }
 
 void lock_release::print(std::ostream &stream) const
@@ -5,14 +5,19 @@
 #include <ostream>
 
 namespace simsync {
-thread_create::thread_create(int32_t parent_id, thread_model &tm, int32_t future_id)
-    : event(parent_id, tm), m_future_thread_id(future_id)
+thread_create::thread_create(int32_t parent_id, int32_t future_id)
+    : event(parent_id, event_type::thread_create), m_future_thread_id(future_id)
 {
 }
 
-transition thread_create::synchronize()
+transition thread_create::synchronize(thread_model &tm) const
 {
-  return m_thread_model.create(m_future_thread_id);
+  return tm.create(m_future_thread_id);
+}
+
+uint64_t thread_create::get_object() const
+{
+  return static_cast<uint64_t>(m_future_thread_id);
 }
 
 void thread_create::print(std::ostream &stream) const
@@ -6,13 +6,13 @@
 
 namespace simsync {
 
-thread_finish::thread_finish(int32_t const thread_id, thread_model &tm) : event(thread_id, tm)
+thread_finish::thread_finish(int32_t const thread_id) : event(thread_id, event_type::thread_finish)
 {
 }
 
-transition thread_finish::synchronize()
+transition thread_finish::synchronize(thread_model &tm) const
 {
-  return m_thread_model.finish(m_thread_id);
+  return tm.finish(m_thread_id);
 }
 
 void thread_finish::print(std::ostream &stream) const
@@ -5,14 +5,19 @@
 #include <ostream>
 
 namespace simsync {
-thread_join::thread_join(int32_t thread_id, thread_model &tm, int32_t target_thread)
-    : event(thread_id, tm), m_target_thread(target_thread)
+thread_join::thread_join(int32_t thread_id, int32_t target_thread)
+    : event(thread_id, event_type::thread_join), m_target_thread(target_thread)
 {
 }
 
-transition thread_join::synchronize()
+transition thread_join::synchronize(thread_model &tm) const
 {
-  return m_thread_model.join(m_thread_id, m_target_thread);
+  return tm.join(m_thread_id, m_target_thread);
+}
+
+uint64_t thread_join::get_object() const
+{
+  return static_cast<uint64_t>(m_target_thread);
 }
 
 void thread_join::print(std::ostream &stream) const
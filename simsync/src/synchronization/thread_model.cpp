@@ -1,6 +1,8 @@
 #include "simsync/synchronization/thread_model.hpp"
 
 #include <algorithm>
+#include <iterator>
+#include <stdexcept>
 
 namespace simsync {
 
@@ -117,6 +119,12 @@ transition thread_model::acquire(int32_t thread_id, uint64_t lock_address)
 {
   transition t{};
 
+  if(m_elided_locks.count(lock_address) > 0) {
+    m_thread_locks[thread_id].push_back(lock_address);
+
+    return t;
+  }
+
   if(!m_lock_queue[lock_address].empty()) {
     if(m_lock_queue[lock_address].front() == thread_id) {
       // the current thread already holds the lock - this can happen due to trylocks
@@ -138,10 +146,44 @@ transition thread_model::acquire(int32_t thread_id, uint64_t lock_address)
   return t;
 }
 
+bool thread_model::is_locked(uint64_t lock_address) const
+{
+  auto const queue = m_lock_queue.find(lock_address);
+
+  return queue != m_lock_queue.end() && !queue->second.empty();
+}
+
+bool thread_model::holds_contended_lock(int32_t const thread_id) const
+{
+  auto const locks = m_thread_locks.find(thread_id);
+  if(locks == m_thread_locks.end()) {
+    return false;
+  }
+
+  for(auto const lock_address : locks->second) {
+    auto const queue = m_lock_queue.find(lock_address);
+    if(queue != m_lock_queue.end() && queue->second.size() > 1 && queue->second.front() == thread_id) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 transition thread_model::release(int32_t thread_id, uint64_t lock_address)
 {
   transition t{};
 
+  if(m_elided_locks.count(lock_address) > 0) {
+    auto &locks = m_thread_locks[thread_id];
+    auto const lock = std::find(locks.rbegin(), locks.rend(), lock_address);
+    if(lock != locks.rend()) {
+      locks.erase(std::next(lock).base());
+    }
+
+    return t;
+  }
+
   if(m_lock_queue[lock_address].front() == thread_id) {
     m_lock_queue[lock_address].pop_front();
     m_thread_locks[thread_id].pop_front();
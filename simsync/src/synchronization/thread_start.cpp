@@ -6,13 +6,13 @@
 
 namespace simsync {
 
-thread_start::thread_start(int32_t const thread_id, thread_model &tm) : event(thread_id, tm)
+thread_start::thread_start(int32_t const thread_id) : event(thread_id, event_type::thread_start)
 {
 }
 
-transition thread_start::synchronize()
+transition thread_start::synchronize(thread_model &tm) const
 {
-  return m_thread_model.start(m_thread_id);
+  return tm.start(m_thread_id);
 }
 
 void thread_start::print(std::ostream &stream) const
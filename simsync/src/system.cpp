@@ -1,9 +1,13 @@
 #include "simsync/system.hpp"
 
 #include "simsync/architecture.hpp"
+#include "simsync/thread.hpp"
 
+#include <algorithm>
 #include <fstream>
+#include <iterator>
 #include <json.hpp>
+#include <stdexcept>
 
 namespace simsync {
 
@@ -16,16 +20,216 @@ system::system(const std::string &config_file, architecture &arch) : m_architect
     m_static_frequencies.emplace(frequency["tid"], frequency["level"]);
   }
 
+  auto const affinity = input["system"].find("affinity");
+  if(affinity != input["system"].end()) {
+    for(auto const &mask : *affinity) {
+      auto const thread_id = mask["tid"].get<int32_t>();
+      auto &cores = m_affinity[thread_id];
+      for(auto const &core_id : mask["cores"]) {
+        if(core_id.get<size_t>() >= m_architecture.size()) {
+          throw std::runtime_error(
+              "Error: the affinity of thread " + std::to_string(thread_id) + " includes a core that does not exist.");
+        }
+        cores.insert(core_id.get<size_t>());
+      }
+
+      if(cores.empty()) {
+        throw std::runtime_error("Error: the affinity of thread " + std::to_string(thread_id) + " has no cores.");
+      }
+    }
+  }
+
+  m_migration_penalty = input["system"].value("migration.penalty", int64_t(0));
+
+  auto const scheduler = input["system"].find("scheduler");
+  m_scheduler = make_scheduler_policy(scheduler != input["system"].end() ? scheduler->get<std::string>() : "fifo");
+
+  governor_options options;
+  auto const window = input["system"].find("governor.window");
+  if(window != input["system"].end()) {
+    options.window = std::chrono::nanoseconds(window->get<int64_t>());
+  }
+  options.up = input["system"].value("governor.up", options.up);
+  options.down = input["system"].value("governor.down", options.down);
+  options.waiting = input["system"].value("governor.waiting", options.waiting);
+
+  auto const governor = input["system"].find("governor");
+  m_governor = make_frequency_governor(governor != input["system"].end() ? governor->get<std::string>() : "static",
+      options);
+
+  auto const timeslice = input["system"].find("timeslice");
+  auto const context_switch = input["system"].find("context.switch");
+  if(timeslice != input["system"].end()) {
+    m_timeslice = std::chrono::nanoseconds(timeslice->get<int64_t>());
+  }
+  if(context_switch != input["system"].end()) {
+    m_context_switch = std::chrono::nanoseconds(context_switch->get<int64_t>());
+  }
+
   for(size_t i = 0; i < m_architecture.size(); ++i) {
     m_available_cores.push_back(i);
   }
+
+  if(m_architecture.has_power()) {
+    m_activity.assign(m_architecture.size(), core_activity{-1, picoseconds(0)});
+    m_energy.cores.assign(m_architecture.size(), 0.0);
+  }
+}
+
+system::system(system const &other, architecture &arch)
+    : m_architecture(arch)
+    , m_available_cores(other.m_available_cores)
+    , m_waiting_threads(other.m_waiting_threads)
+    , m_thread_assignment(other.m_thread_assignment)
+    , m_executing_threads(other.m_executing_threads)
+    , m_sleeping_threads(other.m_sleeping_threads)
+    , m_static_frequencies(other.m_static_frequencies)
+    , m_affinity(other.m_affinity)
+    , m_migration_penalty(other.m_migration_penalty)
+    , m_last_core(other.m_last_core)
+    , m_migrations(other.m_migrations)
+    , m_activity(other.m_activity)
+    , m_energy(other.m_energy)
+    , m_changes(other.m_changes)
+    , m_scheduler(other.m_scheduler->clone())
+    , m_governor(other.m_governor->clone())
+    , m_timeslice(other.m_timeslice)
+    , m_context_switch(other.m_context_switch)
+    , m_time(other.m_time)
+    , m_slice_start(other.m_slice_start)
+    , m_next_preemption(other.m_next_preemption)
+{
+}
+
+void system::restore(system const &other)
+{
+  if(other.m_architecture.size() != m_architecture.size()) {
+    throw std::runtime_error("Error: the system to restore from has a different number of cores.");
+  }
+
+  m_available_cores = other.m_available_cores;
+  m_waiting_threads = other.m_waiting_threads;
+  m_thread_assignment = other.m_thread_assignment;
+  m_executing_threads = other.m_executing_threads;
+  m_sleeping_threads = other.m_sleeping_threads;
+  m_changes = other.m_changes;
+  m_last_core = other.m_last_core;
+  m_migrations = other.m_migrations;
+  m_time = other.m_time;
+  m_slice_start = other.m_slice_start;
+  plan_preemption();
+  m_scheduler->restore(*other.m_scheduler, m_time);
+  m_governor->restore(*other.m_governor, m_time);
+
+  for(size_t core_id = 0; core_id < m_architecture.size(); ++core_id) {
+    m_architecture.get_core(core_id).set_busy_siblings(0);
+  }
+
+  // the energy up to the restore is the other system's, at the levels its cores were at, and is accumulated from the
+  // restore on at this architecture's power
+  if(m_architecture.has_power()) {
+    m_activity.assign(m_architecture.size(), core_activity{-1, m_time});
+    for(auto const &assignment : m_thread_assignment) {
+      m_activity[assignment.second].thread_id = assignment.first;
+    }
+
+    if(other.m_activity.empty()) {
+      m_energy = energy_totals{};
+      m_energy.cores.assign(m_architecture.size(), 0.0);
+    } else {
+      m_energy = other.energy(m_time);
+    }
+  }
+
+  for(auto const &assignment : m_thread_assignment) {
+    m_architecture.get_core(assignment.second).scale_frequency(static_frequency(assignment.first));
+    for(auto const sibling : m_architecture.siblings(assignment.second)) {
+      auto &c = m_architecture.get_core(sibling);
+      c.set_busy_siblings(c.busy_siblings() + 1);
+    }
+  }
+}
+
+void system::set_scheduler(std::unique_ptr<scheduler_policy> policy)
+{
+  m_scheduler = std::move(policy);
+}
+
+void system::set_governor(std::unique_ptr<frequency_governor> governor)
+{
+  m_governor = std::move(governor);
+}
+
+void system::govern(thread_model const &tm)
+{
+  if(!m_governor->is_dynamic()) {
+    return;
+  }
+
+  for(auto const &assignment : m_thread_assignment) {
+    auto &c = m_architecture.get_core(assignment.second);
+    auto const level = m_governor->level(assignment.first, assignment.second, *this, tm);
+
+    if(level == c.level()) {
+      continue;
+    }
+
+    // levels of the same frequency may still draw different power
+    if(!m_activity.empty()) {
+      account(assignment.second);
+    }
+    auto const frequency = c.frequency();
+    c.scale_frequency(level);
+    if(c.frequency() != frequency) {
+      m_changes.push_back(schedule_change{assignment.first, assignment.second, true, false, true});
+    }
+  }
+}
+
+void system::set_preemption(picoseconds const timeslice, picoseconds const context_switch)
+{
+  m_timeslice = timeslice;
+  m_context_switch = context_switch;
+  plan_preemption();
+}
+
+void system::preempt()
+{
+  // threads that have had their core since the previous tick, longest running first
+  std::vector<std::pair<picoseconds, int32_t>> expired;
+  for(auto const &s : m_slice_start) {
+    if(s.second <= m_time - m_timeslice) {
+      expired.emplace_back(s.second, s.first);
+    }
+  }
+  std::sort(expired.begin(), expired.end());
+  expired.resize(std::min(expired.size(), m_waiting_threads.size()));
+
+  auto const first_change = m_changes.size();
+  for(auto const &e : expired) {
+    m_executing_threads.erase(e.second);
+    free_core(e.second);
+  }
+
+  // preempted threads wait behind the threads that were already waiting
+  for(auto const &e : expired) {
+    m_waiting_threads.push_back(e.second);
+  }
+
+  // cores no waiting thread had the affinity for go back to threads that do
+  while(schedule_waiting_thread()) {
+  }
+
+  for(auto change = first_change; change < m_changes.size(); ++change) {
+    m_changes[change].switched = true;
+  }
 }
 
 void system::schedule(int32_t const thread_id)
 {
   auto thread_it = m_executing_threads.find(thread_id);
   if(thread_it == m_executing_threads.end()) {
-    if(!m_available_cores.empty()) {
+    if(has_available_core(thread_id)) {
       use_next_core(thread_id);
     } else {
       // no cores available, need to wait
@@ -81,6 +285,16 @@ void system::erase(int32_t thread_id)
   }
 }
 
+void system::take_changes(std::vector<schedule_change> *changes)
+{
+  changes->clear();
+  changes->swap(m_changes);
+
+  if(m_timeslice.count() > 0) {
+    plan_preemption();
+  }
+}
+
 core const &system::get_thread_core(int32_t const thread_id) const
 {
   auto assignment_it = m_thread_assignment.find(thread_id);
@@ -91,33 +305,238 @@ core const &system::get_thread_core(int32_t const thread_id) const
   throw std::runtime_error("Error: the requested thread is not assigned to a core.");
 }
 
+size_t system::get_thread_core_id(int32_t const thread_id) const
+{
+  auto assignment_it = m_thread_assignment.find(thread_id);
+  if(assignment_it != m_thread_assignment.end()) {
+    return assignment_it->second;
+  }
+
+  throw std::runtime_error("Error: the requested thread is not assigned to a core.");
+}
+
+int32_t system::static_frequency(int32_t const thread_id) const
+{
+  auto const frequency_it = m_static_frequencies.find(thread_id);
+  if(frequency_it != m_static_frequencies.end()) {
+    return frequency_it->second;
+  }
+
+  // threads of applications scheduled together default to the level of the same thread in the first application
+  return thread_id >= application_thread_stride ? static_frequency(thread_id % application_thread_stride) : 0;
+}
+
+energy_totals system::energy(picoseconds const until) const
+{
+  auto totals = m_energy;
+
+  for(size_t core_id = 0; core_id < m_activity.size(); ++core_id) {
+    auto const joules = pending_energy(core_id, until);
+    totals.cores[core_id] += joules;
+    if(m_activity[core_id].thread_id >= 0) {
+      totals.threads[m_activity[core_id].thread_id] += joules;
+    }
+  }
+
+  return totals;
+}
+
+bool system::is_allowed(int32_t const thread_id, size_t const core_id) const
+{
+  auto const cores = affinity(thread_id);
+
+  return cores == nullptr || cores->count(core_id) > 0;
+}
+
+std::set<size_t> const *system::affinity(int32_t const thread_id) const
+{
+  auto const affinity_it = m_affinity.find(thread_id);
+  if(affinity_it != m_affinity.end()) {
+    return &affinity_it->second;
+  }
+
+  // threads of applications scheduled together default to the affinity of the same thread in the first application
+  return thread_id >= application_thread_stride ? affinity(thread_id % application_thread_stride) : nullptr;
+}
+
+bool system::has_available_core(int32_t const thread_id) const
+{
+  if(m_affinity.empty()) {
+    return !m_available_cores.empty();
+  }
+
+  for(auto const core_id : m_available_cores) {
+    if(is_allowed(thread_id, core_id)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 void system::use_next_core(int32_t const thread_id)
 {
-  auto const core_id = m_available_cores.front();
-  m_available_cores.pop_front();
+  size_t core_id = 0;
+  if(affinity(thread_id) == nullptr) {
+    auto const position = m_scheduler->choose_core(thread_id, m_available_cores, *this);
+    core_id = m_available_cores[position];
+    m_available_cores.erase(m_available_cores.begin() + position);
+  } else {
+    // the policy chooses among the available cores the thread may run on
+    std::deque<size_t> allowed;
+    std::copy_if(m_available_cores.begin(), m_available_cores.end(), std::back_inserter(allowed),
+        [&](size_t const c) { return is_allowed(thread_id, c); });
+
+    core_id = allowed[m_scheduler->choose_core(thread_id, allowed, *this)];
+    m_available_cores.erase(std::find(m_available_cores.begin(), m_available_cores.end(), core_id));
+  }
+
+  auto const last_core = m_last_core.find(thread_id);
+  auto const migrated = last_core != m_last_core.end() && last_core->second != core_id;
+  if(migrated) {
+    ++m_migrations[thread_id];
+  }
+  m_last_core[thread_id] = core_id;
+
+  if(!m_activity.empty()) {
+    account(core_id);
+    m_activity[core_id].thread_id = thread_id;
+  }
 
   m_thread_assignment[thread_id] = core_id;
-  m_architecture.get_core(core_id).scale_frequency(m_static_frequencies[thread_id]);
+  m_slice_start[thread_id] = m_time;
+  m_architecture.get_core(core_id).scale_frequency(static_frequency(thread_id));
 
   // thread should now be executing
   m_executing_threads.insert(thread_id);
+  m_changes.push_back(schedule_change{thread_id, core_id, true, false, false, migrated});
+
+  if(m_architecture.has_siblings()) {
+    update_siblings(core_id, true);
+  }
+}
+
+void system::update_siblings(size_t const core_id, bool const busy)
+{
+  for(auto const sibling : m_architecture.siblings(core_id)) {
+    // the siblings' share of the physical core's power changes with them
+    if(!m_activity.empty()) {
+      account(sibling);
+    }
+
+    auto &c = m_architecture.get_core(sibling);
+    c.set_busy_siblings(busy ? c.busy_siblings() + 1 : c.busy_siblings() - 1);
+  }
+
+  // threads on the siblings continue at their new CPI
+  for(auto const &assignment : m_thread_assignment) {
+    auto const &siblings = m_architecture.siblings(core_id);
+    if(std::find(siblings.begin(), siblings.end(), assignment.second) != siblings.end()) {
+      m_changes.push_back(schedule_change{assignment.first, assignment.second, true, false, true});
+    }
+  }
 }
 
 void system::free_core(int32_t const thread_id)
 {
-  m_available_cores.push_back(m_thread_assignment[thread_id]);
+  auto const core_id = m_thread_assignment[thread_id];
+  if(!m_activity.empty()) {
+    account(core_id);
+    m_activity[core_id].thread_id = -1;
+  }
+
+  m_available_cores.push_back(core_id);
   m_thread_assignment.erase(thread_id);
+  m_slice_start.erase(thread_id);
+  m_changes.push_back(schedule_change{thread_id, core_id, false});
+
+  if(m_architecture.has_siblings()) {
+    update_siblings(core_id, false);
+  }
 
   schedule_waiting_thread();
 }
 
-void system::schedule_waiting_thread()
+bool system::schedule_waiting_thread()
 {
-  if(!m_waiting_threads.empty() && !m_available_cores.empty()) {
-    auto const next_thread = m_waiting_threads.front();
-    m_waiting_threads.pop_front();
+  if(m_waiting_threads.empty() || m_available_cores.empty()) {
+    return false;
+  }
+
+  if(m_affinity.empty()) {
+    auto const position = m_scheduler->choose_thread(m_waiting_threads, *this);
+    auto const next_thread = m_waiting_threads[position];
+    m_waiting_threads.erase(m_waiting_threads.begin() + position);
 
     use_next_core(next_thread);
+
+    return true;
+  }
+
+  // the policy chooses among the waiting threads that may run on an available core
+  std::deque<int32_t> eligible;
+  std::copy_if(m_waiting_threads.begin(), m_waiting_threads.end(), std::back_inserter(eligible),
+      [&](int32_t const t) { return has_available_core(t); });
+  if(eligible.empty()) {
+    return false;
   }
+
+  auto const next_thread = eligible[m_scheduler->choose_thread(eligible, *this)];
+  m_waiting_threads.erase(std::find(m_waiting_threads.begin(), m_waiting_threads.end(), next_thread));
+
+  use_next_core(next_thread);
+
+  return true;
+}
+
+void system::plan_preemption()
+{
+  m_next_preemption = picoseconds::max();
+  if(m_timeslice.count() <= 0 || m_waiting_threads.empty() || m_slice_start.empty()) {
+    return;
+  }
+
+  auto earliest = picoseconds::max();
+  for(auto const &s : m_slice_start) {
+    earliest = std::min(earliest, s.second);
+  }
+
+  // the first tick a full time slice after the earliest start, that has not already passed
+  auto const slice = m_timeslice.count();
+  auto const eligible = (earliest.count() + slice - 1) / slice + 1;
+  auto const upcoming = m_time.count() / slice + 1;
+
+  m_next_preemption = picoseconds(std::max(eligible, upcoming) * slice);
+}
+
+void system::account(size_t const core_id)
+{
+  auto &a = m_activity[core_id];
+
+  auto const joules = pending_energy(core_id, m_time);
+  m_energy.cores[core_id] += joules;
+  if(a.thread_id >= 0) {
+    m_energy.threads[a.thread_id] += joules;
+  }
+
+  a.since = m_time;
+}
+
+double system::pending_energy(size_t const core_id, picoseconds const until) const
+{
+  auto const &a = m_activity[core_id];
+  auto const &c = m_architecture.get_core(core_id);
+  auto const seconds = std::chrono::duration<double>(until - a.since).count();
+
+  // siblings share their physical core's power: the busy ones split the active power, and only a core whose siblings
+  // are all idle draws a share of the idle power
+  if(a.thread_id >= 0) {
+    return c.active_power() / static_cast<double>(1 + c.busy_siblings()) * seconds;
+  }
+  if(c.busy_siblings() > 0) {
+    return 0.0;
+  }
+
+  return c.type().idle_power() / static_cast<double>(1 + m_architecture.siblings(core_id).size()) * seconds;
 }
 }
@@ -0,0 +1,353 @@
+#include "simsync/thread_tracker.hpp"
+
+#include "simsync/core.hpp"
+#include "simsync/cpi_sampler.hpp"
+#include "simsync/thread.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMSYNC_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace simsync {
+
+// the index of the first minimum value
+size_t first_min_portable(int64_t const *values, size_t const size)
+{
+  size_t index = 0;
+  for(size_t i = 1; i < size; ++i) {
+    if(values[i] < values[index]) {
+      index = i;
+    }
+  }
+
+  return index;
+}
+
+void subtract_portable(int64_t *values, size_t const size, int64_t const amount)
+{
+  for(size_t i = 0; i < size; ++i) {
+    values[i] -= amount;
+  }
+}
+
+#ifdef SIMSYNC_X86_KERNELS
+__attribute__((target("avx2"))) size_t first_min_avx2(int64_t const *values, size_t const size)
+{
+  size_t i = 0;
+  auto minimum = std::numeric_limits<int64_t>::max();
+
+  if(size >= 4) {
+    auto lanes = _mm256_set1_epi64x(minimum);
+    for(; i + 4 <= size; i += 4) {
+      auto const v = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(values + i));
+      lanes = _mm256_blendv_epi8(lanes, v, _mm256_cmpgt_epi64(lanes, v));
+    }
+
+    alignas(32) int64_t reduced[4];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(reduced), lanes);
+    minimum = std::min(std::min(reduced[0], reduced[1]), std::min(reduced[2], reduced[3]));
+  }
+
+  for(; i < size; ++i) {
+    minimum = std::min(minimum, values[i]);
+  }
+
+  // find the first lane holding the minimum
+  auto const target = _mm256_set1_epi64x(minimum);
+  for(i = 0; i + 4 <= size; i += 4) {
+    auto const v = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(values + i));
+    auto const mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(v, target)));
+    if(mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+
+  while(values[i] != minimum) {
+    ++i;
+  }
+
+  return i;
+}
+
+__attribute__((target("avx2"))) void subtract_avx2(int64_t *values, size_t const size, int64_t const amount)
+{
+  size_t i = 0;
+  auto const lanes = _mm256_set1_epi64x(amount);
+  for(; i + 4 <= size; i += 4) {
+    auto *address = reinterpret_cast<__m256i *>(values + i);
+    _mm256_storeu_si256(address, _mm256_sub_epi64(_mm256_loadu_si256(address), lanes));
+  }
+
+  for(; i < size; ++i) {
+    values[i] -= amount;
+  }
+}
+
+__attribute__((target("avx512f"))) size_t first_min_avx512(int64_t const *values, size_t const size)
+{
+  size_t i = 0;
+  auto minimum = std::numeric_limits<int64_t>::max();
+
+  if(size >= 8) {
+    // the unmasked forms of these intrinsics start from an uninitialized vector, which GCC 12 warns about, so every
+    // lane is selected through a full mask instead; the instructions are the same
+    auto const all = static_cast<__mmask8>(0xff);
+    auto lanes = _mm512_set1_epi64(minimum);
+    for(; i + 8 <= size; i += 8) {
+      lanes = _mm512_mask_min_epi64(lanes, all, lanes, _mm512_loadu_si512(values + i));
+    }
+
+    // fold the lanes in half three times: swap the 256-bit halves, then the 128-bit quarters, then the 64-bit lanes
+    lanes = _mm512_mask_min_epi64(
+        lanes, all, lanes, _mm512_mask_shuffle_i64x2(lanes, all, lanes, lanes, _MM_SHUFFLE(1, 0, 3, 2)));
+    lanes = _mm512_mask_min_epi64(
+        lanes, all, lanes, _mm512_mask_shuffle_i64x2(lanes, all, lanes, lanes, _MM_SHUFFLE(2, 3, 0, 1)));
+    lanes = _mm512_mask_min_epi64(
+        lanes, all, lanes, _mm512_mask_shuffle_epi32(lanes, static_cast<__mmask16>(0xffff), lanes, _MM_PERM_BADC));
+
+    minimum = _mm_cvtsi128_si64(_mm512_mask_extracti32x4_epi32(_mm_setzero_si128(), 0xf, lanes, 0));
+  }
+
+  for(; i < size; ++i) {
+    minimum = std::min(minimum, values[i]);
+  }
+
+  // find the first lane holding the minimum
+  auto const target = _mm512_set1_epi64(minimum);
+  for(i = 0; i + 8 <= size; i += 8) {
+    auto const mask = _mm512_cmpeq_epi64_mask(_mm512_loadu_si512(values + i), target);
+    if(mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+
+  while(values[i] != minimum) {
+    ++i;
+  }
+
+  return i;
+}
+
+__attribute__((target("avx512f"))) void subtract_avx512(int64_t *values, size_t const size, int64_t const amount)
+{
+  size_t i = 0;
+  auto const lanes = _mm512_set1_epi64(amount);
+  for(; i + 8 <= size; i += 8) {
+    _mm512_storeu_si512(values + i, _mm512_sub_epi64(_mm512_loadu_si512(values + i), lanes));
+  }
+
+  for(; i < size; ++i) {
+    values[i] -= amount;
+  }
+}
+#endif
+
+/**
+ * The kernels used to find the next thread and progress threads, chosen once for the host CPU.
+ */
+struct kernels {
+  size_t (*first_min)(int64_t const *, size_t) = first_min_portable;
+  void (*subtract)(int64_t *, size_t, int64_t) = subtract_portable;
+
+  kernels()
+  {
+#ifdef SIMSYNC_X86_KERNELS
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512f")) {
+      first_min = first_min_avx512;
+      subtract = subtract_avx512;
+    } else if(__builtin_cpu_supports("avx2")) {
+      first_min = first_min_avx2;
+      subtract = subtract_avx2;
+    }
+#endif
+  }
+};
+
+kernels const &host_kernels()
+{
+  static kernels const selected;
+  return selected;
+}
+
+thread_tracker::thread_tracker(std::map<int32_t, thread> const &threads) : m_threads(threads)
+{
+  for(auto const &t : threads) {
+    m_current_index[t.first] = 0;
+  }
+}
+
+size_t thread_tracker::current_index(int32_t const thread_id) const
+{
+  return m_current_index.at(thread_id);
+}
+
+picoseconds thread_tracker::time_remaining(int32_t const thread_id) const
+{
+  return picoseconds(m_time[slot(thread_id)]);
+}
+
+void thread_tracker::start(int32_t const thread_id, core const &c)
+{
+  auto const position = std::lower_bound(m_ids.begin(), m_ids.end(), thread_id);
+  if(position != m_ids.end() && *position == thread_id) {
+    throw std::runtime_error("Error: thread started executing twice.");
+  }
+
+  auto const index = static_cast<size_t>(position - m_ids.begin());
+  m_ids.insert(position, thread_id);
+  m_time.insert(m_time.begin() + index, 0);
+  m_computation.insert(m_computation.begin() + index, 0);
+  m_cpi.insert(m_cpi.begin() + index, c.get_cpi(thread_id));
+  m_cpi_stddev.insert(m_cpi_stddev.begin() + index, c.get_cpi_stddev(thread_id));
+  m_frequency.insert(m_frequency.begin() + index, c.frequency());
+
+  auto const suspended = m_suspended.find(thread_id);
+  if(suspended == m_suspended.end()) {
+    m_time[index] = m_computation[index] = computation_time(thread_id, index);
+    return;
+  }
+
+  auto const &s = suspended->second;
+  auto const old_cpi = current_cpi(thread_id, s.cpi, s.cpi_stddev);
+  auto const new_cpi = current_cpi(thread_id, m_cpi[index], m_cpi_stddev[index]);
+  m_computation[index] =
+      rescale_time(picoseconds(s.time), old_cpi, s.frequency, new_cpi, m_frequency[index]).count();
+  m_time[index] = s.wait + m_computation[index];
+
+  m_suspended.erase(suspended);
+}
+
+void thread_tracker::stop(int32_t const thread_id)
+{
+  auto const index = slot(thread_id);
+
+  m_ids.erase(m_ids.begin() + index);
+  m_time.erase(m_time.begin() + index);
+  m_computation.erase(m_computation.begin() + index);
+  m_cpi.erase(m_cpi.begin() + index);
+  m_cpi_stddev.erase(m_cpi_stddev.begin() + index);
+  m_frequency.erase(m_frequency.begin() + index);
+}
+
+void thread_tracker::suspend(int32_t const thread_id)
+{
+  auto const index = slot(thread_id);
+  auto const wait = pending_wait(index);
+  m_suspended[thread_id] =
+      suspension{m_time[index] - wait, wait, m_cpi[index], m_cpi_stddev[index], m_frequency[index]};
+
+  stop(thread_id);
+}
+
+int32_t thread_tracker::next_thread(picoseconds *elapsed_time) const
+{
+  auto const index = host_kernels().first_min(m_time.data(), m_time.size());
+  *elapsed_time = picoseconds(m_time[index]);
+
+  return m_ids[index];
+}
+
+void thread_tracker::progress(int32_t const next_thread, picoseconds const time)
+{
+  // the time to reach an event shrinks by exactly the time elapsed, as time and work convert exactly
+  host_kernels().subtract(m_time.data(), m_time.size(), time.count());
+
+  seek(next_thread, m_current_index[next_thread] + 1);
+}
+
+void thread_tracker::seek(int32_t const thread_id, size_t const index)
+{
+  m_current_index[thread_id] = index;
+
+  auto const position = std::lower_bound(m_ids.begin(), m_ids.end(), thread_id);
+  if(position != m_ids.end() && *position == thread_id) {
+    auto const executing_slot = static_cast<size_t>(position - m_ids.begin());
+    m_time[executing_slot] = m_computation[executing_slot] = computation_time(thread_id, executing_slot);
+  }
+}
+
+void thread_tracker::elapse(picoseconds const time)
+{
+  host_kernels().subtract(m_time.data(), m_time.size(), time.count());
+}
+
+void thread_tracker::delay(int32_t const thread_id, picoseconds const time)
+{
+  // the computation only continues once the wait is over, so it keeps the time it needs
+  auto const index = slot(thread_id);
+  m_computation[index] = std::min(m_time[index], m_computation[index]);
+  m_time[index] += time.count();
+}
+
+void thread_tracker::extend(int32_t const thread_id, picoseconds const time)
+{
+  auto const index = slot(thread_id);
+  m_computation[index] = std::min(m_time[index], m_computation[index]) + time.count();
+  m_time[index] += time.count();
+}
+
+void thread_tracker::retime(int32_t const thread_id, core const &c)
+{
+  auto const index = slot(thread_id);
+  auto const cpi = c.get_cpi(thread_id);
+  auto const cpi_stddev = c.get_cpi_stddev(thread_id);
+  auto const frequency = c.frequency();
+
+  if(cpi != m_cpi[index] || cpi_stddev != m_cpi_stddev[index] || frequency != m_frequency[index]) {
+    auto const old_cpi = current_cpi(thread_id, m_cpi[index], m_cpi_stddev[index]);
+    auto const new_cpi = current_cpi(thread_id, cpi, cpi_stddev);
+
+    // only the computation changes speed; a wait lasts as long as it did
+    auto const wait = pending_wait(index);
+    m_computation[index] =
+        rescale_time(picoseconds(m_time[index] - wait), old_cpi, m_frequency[index], new_cpi, frequency).count();
+    m_time[index] = wait + m_computation[index];
+    m_cpi[index] = cpi;
+    m_cpi_stddev[index] = cpi_stddev;
+    m_frequency[index] = frequency;
+  }
+}
+
+size_t thread_tracker::slot(int32_t const thread_id) const
+{
+  auto const position = std::lower_bound(m_ids.begin(), m_ids.end(), thread_id);
+  if(position == m_ids.end() || *position != thread_id) {
+    throw std::runtime_error("Error: the requested thread is not executing.");
+  }
+
+  return static_cast<size_t>(position - m_ids.begin());
+}
+
+int64_t thread_tracker::pending_wait(size_t const slot) const
+{
+  return std::max<int64_t>(m_time[slot] - m_computation[slot], 0);
+}
+
+fixed_cpi thread_tracker::current_cpi(int32_t const thread_id, fixed_cpi const cpi, fixed_cpi const cpi_stddev) const
+{
+  if(m_sampler == nullptr) {
+    return cpi;
+  }
+
+  return m_sampler->sample(cpi, cpi_stddev, thread_id, m_current_index.at(thread_id));
+}
+
+int64_t thread_tracker::computation_time(int32_t const thread_id, size_t const slot) const
+{
+  auto const &t = m_threads.at(thread_id);
+  auto const index = m_current_index.at(thread_id);
+
+  // there is no computation after the last event
+  auto const instructions = index < t.size() ? t.get_computation(index) : 0;
+
+  auto const cpi = current_cpi(thread_id, m_cpi[slot], m_cpi_stddev[slot]);
+
+  return estimate_time(instructions, 0, cpi, m_frequency[slot]).count();
+}
+}
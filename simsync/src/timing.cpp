@@ -0,0 +1,80 @@
+#include "simsync/timing.hpp"
+
+#include <cmath>
+
+namespace simsync {
+
+#if !defined(__SIZEOF_INT128__)
+#error "simsync requires a compiler with 128-bit integer support"
+#endif
+
+// products of instructions, CPIs and frequencies overflow 64 bits, but never 128 bits
+__extension__ typedef unsigned __int128 wide_t;
+
+// work needed for a single instruction, in hertz-picoseconds (i.e., 1e-12 cycles)
+inline wide_t instruction_work(fixed_cpi const cpi)
+{
+  return static_cast<wide_t>(cpi) * (1000000000000 / cpi_scale);
+}
+
+// 128-bit division is a library call, so divide in 64 bits whenever the dividend allows it
+inline wide_t divide(wide_t const dividend, wide_t const divisor, wide_t *remainder)
+{
+  if((dividend >> 64) == 0 && (divisor >> 64) == 0) {
+    auto const narrow_dividend = static_cast<uint64_t>(dividend);
+    auto const narrow_divisor = static_cast<uint64_t>(divisor);
+
+    *remainder = narrow_dividend % narrow_divisor;
+    return narrow_dividend / narrow_divisor;
+  }
+
+  *remainder = dividend % divisor;
+  return dividend / divisor;
+}
+
+fixed_cpi to_fixed_cpi(double const cpi_rate)
+{
+  return static_cast<fixed_cpi>(std::llround(cpi_rate * cpi_scale));
+}
+
+picoseconds estimate_time(
+    uint64_t const instructions, uint64_t const progress, fixed_cpi const cpi, int64_t const frequency)
+{
+  auto const work = static_cast<wide_t>(instructions) * instruction_work(cpi);
+  auto const remaining = work > progress ? work - progress : 0;
+
+  wide_t remainder = 0;
+  auto const time = divide(remaining, static_cast<wide_t>(frequency), &remainder);
+
+  return picoseconds(static_cast<int64_t>(time + (remainder != 0 ? 1 : 0)));
+}
+
+uint64_t estimate_instructions(
+    picoseconds const time, fixed_cpi const cpi, int64_t const frequency, uint64_t *progress)
+{
+  auto const per_instruction = instruction_work(cpi);
+  auto const work = static_cast<wide_t>(time.count()) * static_cast<wide_t>(frequency) + *progress;
+
+  wide_t remainder = 0;
+  auto const instructions = divide(work, per_instruction, &remainder);
+  *progress = static_cast<uint64_t>(remainder);
+
+  return static_cast<uint64_t>(instructions);
+}
+
+picoseconds rescale_time(picoseconds const remaining,
+    fixed_cpi const old_cpi,
+    int64_t const old_frequency,
+    fixed_cpi const cpi,
+    int64_t const frequency)
+{
+  // the remaining work in hertz-picoseconds, converted to instructions at the old CPI and back at the new one
+  auto const work = static_cast<wide_t>(remaining.count()) * static_cast<wide_t>(old_frequency) * cpi;
+  auto const divisor = static_cast<wide_t>(old_cpi) * static_cast<wide_t>(frequency);
+
+  wide_t remainder = 0;
+  auto const time = divide(work, divisor, &remainder);
+
+  return picoseconds(static_cast<int64_t>(time + (remainder != 0 ? 1 : 0)));
+}
+}